@@ -75,10 +75,11 @@ void AKC695X::setI2CBusAddress(int deviceAddress)
  */
 void AKC695X::setup(int resetPin, uint8_t crystal_type)
 {
+    AKC695XTraceScope scope(this, AKC_API_SETUP);
     this->resetPin = resetPin;
     if (resetPin >= 0)
         reset();
-    Wire.begin();
+    busBegin();
     setCrystalType(crystal_type);
 }
 
@@ -102,6 +103,113 @@ void AKC695X::setup(int resetPin) {
     this->setup(resetPin, CRYSTAL_32KHz);
 }
 
+/**
+ * @ingroup  GA03
+ * @brief    Fast receiver startup
+ * @details  Brings the receiver up with the whole initial configuration (crystal, audio, volume control, band and frequency)
+ * @details  written as one precomputed register image. It replaces the sequence setup, setFM (or setAM) and setAudio.
+ * @details  No register is read. The RESET pulse uses the minimum times AKC_RESET_PULSE_TIME and AKC_RESET_WAIT_TIME.
+ * @details  The registers not written (REG07, REG08, REG11 to REG13) keep the device defaults.
+ * @details  If timing is not NULL, the method waits for the STC bit (up to MAX_TUNE_TIME) and fills the boot time breakdown.
+ * @code
+ * akc_boot_timing bootTime;
+ * void setup() {
+ *    // FM, band 0, 87.0 to 108.0 MHz, tunes on 103.9MHz, step 100kHz and volume 40
+ *    radio.fastSetup(RESET_PIN, CRYSTAL_32KHz, AKC_FM, 0, 870, 1080, 1039, 1, 40, &bootTime);
+ *    Serial.println(bootTime.total);
+ * }
+ * @endcode
+ *
+ * @see setup, setFM, setAM, setAudio, akc_boot_timing
+ *
+ * @param resetPin          if >= 0,  then you control the RESET. if -1, you are using ths MCU RST pin.
+ * @param crystal_type      CRYSTAL_32KHz or CRYSTAL_12MHZ
+ * @param fm_en             AKC_FM or AKC_AM
+ * @param band              FM or AM band (see setFM and setAM band tables)
+ * @param minimum_freq      Minimal frequency of the band
+ * @param maximum_freq      Band maximum frequency
+ * @param default_frequency default frequency
+ * @param default_step      increment and decrement step
+ * @param volume            audio volume (controlled by the MCU)
+ * @param timing            Optional. Boot time breakdown (NULL = do not measure)
+ */
+void AKC695X::fastSetup(int resetPin, uint8_t crystal_type, uint8_t fm_en, uint8_t band, uint16_t minimum_freq, uint16_t maximum_freq, uint16_t default_frequency, uint8_t default_step, uint8_t volume, akc_boot_timing *timing)
+{
+    uint8_t image[6]; // REG01 to REG06
+    uint8_t reg0;
+    uint16_t channel;
+    uint32_t start, phase;
+
+    start = phase = micros();
+    AKC695XTraceScope scope(this, AKC_API_SETUP);
+
+    this->resetPin = resetPin;
+    if (resetPin >= 0)
+    {
+        pinMode(resetPin, OUTPUT);
+        digitalWrite(resetPin, LOW);
+        delay(AKC_RESET_PULSE_TIME);
+        digitalWrite(resetPin, HIGH);
+        delay(AKC_RESET_WAIT_TIME);
+    }
+    busBegin();
+
+    if (timing != NULL)
+    {
+        timing->reset = micros() - phase;
+        phase = micros();
+    }
+
+    this->currentCrystalType = crystal_type;
+    this->currentMode = fm_en;
+    this->currentBand = band;
+    this->currentBandMinimumFrequency = minimum_freq;
+    this->currentBandMaximumFrequency = maximum_freq;
+    this->currentFrequency = default_frequency;
+    this->currentStep = default_step;
+    this->volume = (volume > 63) ? 63 : volume;
+
+    // The register image REG01 to REG06 is written in one burst
+    image[0] = (fm_en) ? akc_reg1_fmband::encode(band) : akc_reg1_amband::encode(band);
+
+    channel = frequencyToChannel(default_frequency);
+    image[1] = akc_fields<akc_reg2_channel, akc_reg2_mode3k, akc_reg2_ref_32k_mode>::encode(channel >> 8, this->currentMode3k, crystal_type);
+    image[2] = channel & 0xFF;
+
+    // Custom band limits (see setCustomBand). The device defaults are kept for the native bands.
+    image[3] = 0x19;
+    image[4] = 0x32;
+#if AKC695X_USE_CUSTOM_BAND
+    if ((fm_en && band > 6) || (!fm_en && band > 17))
+    {
+        image[3] = frequencyToChannel(minimum_freq) / 32;
+        image[4] = frequencyToChannel(maximum_freq) / 32;
+    }
+#endif
+
+    image[5] = akc_reg6_volume::encode(this->volume);
+
+    setRegisters(REG01, image, 6);
+
+    // Device default value (0x07) with the volume controlled by the MCU (see setVolumeControl)
+    setRegister(REG09, akc_reg9_pd_adc_vol::set(0x07, 1));
+
+    // Power on and tune (see commitTune)
+    reg0 = akc_fields<akc_reg0_power_on, akc_reg0_fm_en>::encode(1, fm_en);
+    setRegister(REG00, akc_reg0_tune::set(reg0, 1));
+    setRegister(REG00, reg0);
+
+    if (timing == NULL)
+        return;
+
+    timing->config = micros() - phase;
+    phase = micros();
+    while (!isTuningComplete() && (micros() - phase) < (MAX_TUNE_TIME * 1000UL))
+        ;
+    timing->tune = micros() - phase;
+    timing->total = micros() - start;
+}
+
 /**
  * @ingroup GA03
  * @brief Power the device on
@@ -116,17 +224,8 @@ void AKC695X::setup(int resetPin) {
  */
 void AKC695X::powerOn(uint8_t fm_en, uint8_t tune, uint8_t mute, uint8_t seek, uint8_t seekup)
 {
-    akc595x_reg0 reg0;
+    setRegister(REG00, akc_fields<akc_reg0_power_on, akc_reg0_fm_en, akc_reg0_mute, akc_reg0_seek, akc_reg0_seekup, akc_reg0_tune>::encode(1, fm_en, mute, seek, seekup, tune));
 
-    reg0.refined.power_on = 1;
-    reg0.refined.rsv = 0;
-    reg0.refined.fm_en = fm_en;
-    reg0.refined.mute = mute;
-    reg0.refined.seek = seek;
-    reg0.refined.seekup = seekup;
-    reg0.refined.tune = tune;
-
-    setRegister(REG00, reg0.raw);
     this->currentMode = fm_en; // Save the current mode (FM or AM)
 }
 
@@ -134,39 +233,450 @@ void AKC695X::powerOn(uint8_t fm_en, uint8_t tune, uint8_t mute, uint8_t seek, u
  * @ingroup GA03
  * @brief Sets a given register with a given value
  * @details It is a basic function to deal with the AKC695X devices
+ * @details The write is repeated if the device does not acknowledge it (see setBusRetries).
  * @param reg  register number to be written (only for RW type registers)
  * @param parameter  value to be written in the register
+ * @return true if the device received the value (see getBusResult)
  */
-void AKC695X::setRegister(uint8_t reg, uint8_t parameter)
+bool AKC695X::setRegister(uint8_t reg, uint8_t parameter)
 {
-    Wire.beginTransmission(this->deviceAddress);
-    Wire.write(reg);
-    Wire.write(parameter);
-    Wire.endTransmission();
-    delayMicroseconds(3000);
+#if AKC695X_USE_TRANSACTION
+    if (this->transactionOpen && reg < AKC_IMAGE_SIZE)
+    {
+        updateRegisterImage(reg, parameter); // It will be written by commitTransaction
+        this->regDirty |= (1 << reg);
+        return true;
+    }
+#endif
+    if (!busTransfer(reg, &parameter, 1, NULL, 0))
+        return false;
+    registerWritten(reg, parameter);
+    return true;
 }
 
 /**
  * @ingroup GA03
  * @brief Gets a given register content
  * @details It is a basic function to get a value from a given AKC695X device register
+ * @details If the read fails (see getBusResult), the last known content of the register is returned (0 if it is not known).
  * @param reg  register number to be read (0 ~ 26)
  * @return the register content
  */
 uint8_t AKC695X::getRegister(uint8_t reg)
 {
     uint8_t result;
+
+#if AKC695X_USE_TRANSACTION
+    if (this->transactionOpen && reg < AKC_IMAGE_SIZE && (this->regImageValid & (1 << reg)))
+        return this->regImage[reg]; // The cached image has the pending changes
+#endif
+
+    if (!busTransfer(reg, NULL, 0, &result, 1))
+        return (reg < AKC_IMAGE_SIZE && (this->regImageValid & (1 << reg))) ? this->regImage[reg] : 0;
+    registerRead(reg, result);
+    return result;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Writes a sequence of registers in a single I2C transaction (burst)
+ * @details The AKC695X increments the register address after each byte. This method is much faster than
+ * @details calling setRegister for each register. The cached register image is updated.
+ *
+ * @param reg     first register to be written
+ * @param values  values to be written
+ * @param count   number of registers (up to 16)
+ * @return true if the device received the values (see getBusResult)
+ */
+bool AKC695X::setRegisters(uint8_t reg, const uint8_t *values, uint8_t count)
+{
+#if AKC695X_USE_TRANSACTION
+    if (this->transactionOpen && (reg + count) <= AKC_IMAGE_SIZE)
+    {
+        for (uint8_t i = 0; i < count; i++)
+            setRegister(reg + i, values[i]);
+        return true;
+    }
+#endif
+    if (!busTransfer(reg, values, count, NULL, 0))
+        return false;
+    for (uint8_t i = 0; i < count; i++)
+        registerWritten(reg + i, values[i]);
+    return true;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Reads a sequence of registers in a single I2C transaction (burst)
+ * @details Useful to get the whole status block (REG20 to REG27) at once.
+ *
+ * @param reg     first register to be read
+ * @param values  array that will receive the register contents
+ * @param count   number of registers (up to 16)
+ * @return true if the registers were read. If false, values is filled with zeros (STC = 0 on the status block)
+ */
+bool AKC695X::getRegisters(uint8_t reg, uint8_t *values, uint8_t count)
+{
+    if (!busTransfer(reg, NULL, 0, values, count))
+        return false;
+    for (uint8_t i = 0; i < count; i++)
+        registerRead(reg + i, values[i]);
+    return true;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Starts the I2C bus
+ * @details If the Wire library of your board supports timeouts (WIRE_HAS_TIMEOUT), a transfer takes at most AKC_BUS_TIMEOUT_TIME
+ * @details and the bus is reset after a timeout. Otherwise, the maximum time of a transfer depends on the Wire library.
+ */
+void AKC695X::busBegin()
+{
+    Wire.begin();
+#ifdef WIRE_HAS_TIMEOUT
+    Wire.setWireTimeout(AKC_BUS_TIMEOUT_TIME, true);
+#endif
+}
+
+/**
+ * @ingroup GA03
+ * @brief Sends the register address followed by some values in a single I2C transaction
+ * @details Single attempt. It does not wait for the guard time.
+ *
+ * @param reg     first register
+ * @param values  values to be written (NULL if count is 0)
+ * @param count   number of values (0 = just selects the register to be read)
+ * @return uint8_t AKC_BUS_OK or the error (AKC_BUS_NACK_ADDRESS to AKC_BUS_TIMEOUT)
+ */
+uint8_t AKC695X::busWrite(uint8_t reg, const uint8_t *values, uint8_t count)
+{
+    uint8_t result;
+
     Wire.beginTransmission(this->deviceAddress);
     Wire.write(reg);
-    Wire.endTransmission();
+    for (uint8_t i = 0; i < count; i++)
+        Wire.write(values[i]);
+    result = Wire.endTransmission();
+#ifdef WIRE_HAS_TIMEOUT
+    if (Wire.getWireTimeoutFlag())
+    {
+        Wire.clearWireTimeoutFlag();
+        result = AKC_BUS_TIMEOUT;
+    }
+#endif
+    return busDone(result);
+}
+
+/**
+ * @ingroup GA03
+ * @brief Reads some bytes from the register selected by busWrite
+ * @details Single attempt. It does not wait for the guard time. If the device sends less bytes than requested,
+ * @details the bytes received are discarded and values is filled with zeros.
+ *
+ * @param values  array that receives the bytes
+ * @param count   number of bytes
+ * @return uint8_t AKC_BUS_OK, AKC_BUS_TIMEOUT or AKC_BUS_SHORT_READ
+ */
+uint8_t AKC695X::busRead(uint8_t *values, uint8_t count)
+{
+    uint8_t result = AKC_BUS_OK;
+
+    if (Wire.requestFrom(this->deviceAddress, count) != count)
+        result = AKC_BUS_SHORT_READ;
+#ifdef WIRE_HAS_TIMEOUT
+    if (Wire.getWireTimeoutFlag())
+    {
+        Wire.clearWireTimeoutFlag();
+        result = AKC_BUS_TIMEOUT;
+    }
+#endif
+    for (uint8_t i = 0; i < count; i++)
+        values[i] = (result == AKC_BUS_OK) ? Wire.read() : 0;
+    while (Wire.available())
+        Wire.read();
+    return busDone(result);
+}
 
-    delayMicroseconds(3000);
-    Wire.requestFrom(this->deviceAddress, 1);
-    result = Wire.read();
-    delayMicroseconds(2000);
+/**
+ * @ingroup GA03
+ * @brief Stores the result of an I2C transaction and counts the errors
+ *
+ * @param result  AKC_BUS_OK or the error
+ * @return uint8_t result
+ */
+uint8_t AKC695X::busDone(uint8_t result)
+{
+    this->busResult = result;
+#if AKC695X_USE_BUS_RECOVERY
+    if (result == AKC_BUS_OK)
+        return result;
+    this->busErrors.last = result;
+    if (result == AKC_BUS_NACK_ADDRESS || result == AKC_BUS_NACK_DATA)
+    {
+        if (this->busErrors.nack < 0xFFFF)
+            this->busErrors.nack++;
+    }
+    else if (result == AKC_BUS_SHORT_READ)
+    {
+        if (this->busErrors.short_read < 0xFFFF)
+            this->busErrors.short_read++;
+    }
+    else if (this->busErrors.timeout < 0xFFFF)
+        this->busErrors.timeout++;
+#endif
     return result;
 }
 
+/**
+ * @ingroup GA03
+ * @brief Runs a blocking I2C transaction with the guard times and the retries
+ * @details Writes the register address and the out values. If in is not NULL, reads in_count bytes after the guard time.
+ * @details A failed transaction is repeated up to the number of retries (see setBusRetries). Before repeating it after a timeout,
+ * @details a bus error or a short read, the bus is recovered (see recoverBus). So, the time of a call is bounded (see getBusMaxTime).
+ *
+ * @param reg        first register
+ * @param out        values to be written (NULL if out_count is 0)
+ * @param out_count  number of values to be written
+ * @param in         array that receives the values read (NULL = write only). Filled with zeros if the transaction fails.
+ * @param in_count   number of values to be read
+ * @return true if the transaction succeeded
+ */
+bool AKC695X::busTransfer(uint8_t reg, const uint8_t *out, uint8_t out_count, uint8_t *in, uint8_t in_count)
+{
+    uint8_t result;
+
+    for (uint8_t attempt = 0;; attempt++)
+    {
+        result = busWrite(reg, out, out_count);
+        delayMicroseconds(AKC_WRITE_GUARD_TIME);
+        if (result == AKC_BUS_OK && in != NULL)
+        {
+            result = busRead(in, in_count);
+            delayMicroseconds(AKC_READ_GUARD_TIME);
+        }
+        if (result == AKC_BUS_OK)
+            return true;
+        if (!busRetry(result, attempt))
+            return false;
+    }
+}
+
+/**
+ * @ingroup GA03
+ * @brief Decides if a failed I2C transaction has to be repeated
+ * @details Before repeating a transaction that failed with a timeout, a bus error or a short read, the bus is recovered (see recoverBus).
+ *
+ * @param result   error of the last attempt
+ * @param attempt  number of failed attempts before the last one
+ * @return true if the transaction has to be repeated; false if the retries are over
+ */
+bool AKC695X::busRetry(uint8_t result, uint8_t attempt)
+{
+#if AKC695X_USE_BUS_RECOVERY
+    if (attempt >= this->busRetries)
+    {
+        if (this->busErrors.failures < 0xFFFF)
+            this->busErrors.failures++;
+        return false;
+    }
+    if (result >= AKC_BUS_OTHER)
+        recoverBus(); // The bus can be stuck
+    if (this->busErrors.retries < 0xFFFF)
+        this->busErrors.retries++;
+    return true;
+#else
+    (void)result;
+    (void)attempt;
+    return false;
+#endif
+}
+
+#if AKC695X_USE_BUS_RECOVERY
+/**
+ * @ingroup GA03
+ * @brief Sets the number of times a failed I2C transaction is repeated
+ * @details A glitch on the bus (a NACK, a timeout or a short read) makes the blocking register methods repeat the transaction.
+ * @details The default value is AKC_BUS_RETRIES. Use 0 to give up at the first error. See getBusMaxTime.
+ *
+ * @param retries  0 to AKC_BUS_MAX_RETRIES
+ */
+void AKC695X::setBusRetries(uint8_t retries)
+{
+    this->busRetries = (retries > AKC_BUS_MAX_RETRIES) ? AKC_BUS_MAX_RETRIES : retries;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Resets the I2C error counters
+ *
+ * @see getBusErrors
+ */
+void AKC695X::clearBusErrors()
+{
+    memset(&this->busErrors, 0, sizeof(this->busErrors));
+}
+
+/**
+ * @ingroup GA03
+ * @brief Releases a stuck I2C bus
+ * @details If a transfer is interrupted (reset of the MCU, noise), the device can keep SDA low waiting for the clock of the rest
+ * @details of a byte. This method takes the SCL and SDA pins from the Wire library, sends up to AKC_BUS_RECOVERY_CLOCKS clock pulses
+ * @details until SDA is released, sends a STOP condition and starts the Wire library again. The pins are never driven high
+ * @details (open drain emulation). It is called by the register methods after a timeout, a bus error or a short read.
+ * @details On boards without the SDA and SCL definitions, just the Wire library is restarted.
+ *
+ * @see setBusRetries
+ */
+void AKC695X::recoverBus()
+{
+#if defined(SDA) && defined(SCL)
+    Wire.end();
+    pinMode(SDA, INPUT_PULLUP);
+    pinMode(SCL, INPUT_PULLUP);
+    for (uint8_t i = 0; i < AKC_BUS_RECOVERY_CLOCKS && digitalRead(SDA) == LOW; i++)
+    {
+        digitalWrite(SCL, LOW);
+        pinMode(SCL, OUTPUT);
+        delayMicroseconds(5);
+        pinMode(SCL, INPUT_PULLUP);
+        delayMicroseconds(5);
+    }
+    // STOP condition: SDA goes high while SCL is high
+    digitalWrite(SCL, LOW);
+    pinMode(SCL, OUTPUT);
+    digitalWrite(SDA, LOW);
+    pinMode(SDA, OUTPUT);
+    delayMicroseconds(5);
+    pinMode(SCL, INPUT_PULLUP);
+    delayMicroseconds(5);
+    pinMode(SDA, INPUT_PULLUP);
+    delayMicroseconds(5);
+#endif
+    busBegin();
+    if (this->busErrors.recoveries < 0xFFFF)
+        this->busErrors.recoveries++;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Gets the worst-case time of a blocking register method call
+ * @details Each attempt takes at most two transfers (register address and data) plus the guard times. A failed attempt may be
+ * @details followed by a bus recovery. The bound holds when the Wire library supports timeouts (WIRE_HAS_TIMEOUT, see busBegin).
+ * @details Methods that call several register methods (setFM, setFrequency etc) take this time for each call.
+ *
+ * @return uint32_t time in us
+ */
+uint32_t AKC695X::getBusMaxTime()
+{
+    uint32_t attempt = 2UL * AKC_BUS_TIMEOUT_TIME + AKC_WRITE_GUARD_TIME + AKC_READ_GUARD_TIME;
+
+    return (this->busRetries + 1) * attempt + this->busRetries * (uint32_t)AKC_BUS_RECOVERY_TIME;
+}
+#endif
+
+/**
+ * @ingroup GA03
+ * @brief Registers a value written to the device
+ * @details Called by all methods that write registers. Updates the cached register image and feeds the trace and the other
+ * @details features that follow the register writes.
+ *
+ * @param reg    register number
+ * @param value  register content
+ */
+void AKC695X::registerWritten(uint8_t reg, uint8_t value)
+{
+    trace(AKC_TRACE_WRITE, reg, value);
+    observeLatency(AKC_TRACE_WRITE, reg, value);
+    tundTrigger(reg, value);
+    updateRegisterImage(reg, value);
+#if AKC695X_USE_STATUS
+    this->statusValid = false; // The next getStatus reads the device
+#endif
+}
+
+/**
+ * @ingroup GA03
+ * @brief Registers a value read from the device
+ * @details Called by all methods that read registers.
+ *
+ * @param reg    register number
+ * @param value  register content
+ */
+void AKC695X::registerRead(uint8_t reg, uint8_t value)
+{
+    trace(AKC_TRACE_READ, reg, value);
+    observeLatency(AKC_TRACE_READ, reg, value);
+    updateRegisterImage(reg, value);
+}
+
+/**
+ * @ingroup GA03
+ * @brief Updates the cached register image
+ * @details Only the RW registers (REG00 to REG13) are stored. Other registers are ignored.
+ *
+ * @param reg    register number
+ * @param value  register content
+ */
+void AKC695X::updateRegisterImage(uint8_t reg, uint8_t value)
+{
+    if (reg >= AKC_IMAGE_SIZE)
+        return;
+    this->regImage[reg] = value;
+    this->regImageValid |= (1 << reg);
+}
+
+/**
+ * @ingroup GA03
+ * @brief Reads the registers that are not known yet
+ * @details If some register of the cached image was never written or read, the whole RW block (REG00 to REG13) is read in a single transaction.
+ */
+void AKC695X::completeRegisterImage()
+{
+    uint8_t image[AKC_IMAGE_SIZE];
+
+    if (this->regImageValid != ((1 << AKC_IMAGE_SIZE) - 1))
+        getRegisters(REG00, image, AKC_IMAGE_SIZE); // getRegisters updates the cached image
+}
+
+/**
+ * @ingroup GA03
+ * @brief Writes some registers of a register image
+ * @details Writes the registers of the mask (REG01 to REG13) coalescing them into bursts.
+ * @details Two registers of the mask are written in the same burst when all registers between them are known.
+ * @details In this case, the registers between them are rewritten with their current value.
+ * @details REG00 is not written. It is handled by the caller because it triggers the tune process.
+ *
+ * @param image  register image (REG00 to REG13)
+ * @param mask   registers to be written (bit n = register n)
+ */
+void AKC695X::writeRegisterImage(const uint8_t *image, uint16_t mask)
+{
+    uint8_t values[AKC_IMAGE_SIZE];
+    uint8_t first, last, reg;
+
+    for (first = REG01; first < AKC_IMAGE_SIZE; first++)
+    {
+        if (!(mask & (1 << first)))
+            continue;
+
+        // Extends the burst up to the last register of the mask that can be reached through known registers
+        last = first;
+        for (reg = first + 1; reg < AKC_IMAGE_SIZE; reg++)
+        {
+            if (mask & (1 << reg))
+                last = reg;
+            else if (!(this->regImageValid & (1 << reg)))
+                break;
+        }
+
+        for (reg = first; reg <= last; reg++)
+            values[reg - first] = (mask & (1 << reg)) ? image[reg] : this->regImage[reg];
+
+        setRegisters(first, values, last - first + 1);
+        first = last;
+    }
+}
+
 /**
  * @ingroup GA03
  * @brief Sets the kind of Crystal
@@ -176,10 +686,7 @@ uint8_t AKC695X::getRegister(uint8_t reg)
  * @param crystal   0 = 12MHz;  1 = 32.768kHz
  */
 void AKC695X::setCrystalType(uint8_t crystal) {
-    akc595x_reg2 reg2;
-    reg2.raw = getRegister(REG02);          // Gets the current value of the register 2
-    reg2.refined.ref_32k_mode = crystal;    // sets the crystal used
-    setRegister(REG02,reg2.raw);
+    setRegister(REG02, akc_reg2_ref_32k_mode::set(getRegister(REG02), crystal)); // Changes just the crystal used
     this->currentCrystalType = crystal;
 }
 
@@ -197,24 +704,35 @@ void AKC695X::setCrystalType(uint8_t crystal) {
  * @return false   No channel
  */
 bool AKC695X::isTuned() {
-    akc595x_reg20 reg20;
-    reg20.raw = getRegister(REG20);
-    return reg20.refined.tuned;
+    return akc_reg20_tuned::get(getRegister(REG20));
 }
 
 /**
  * @ingroup GA03A
  * @brief Gets the Status of seeking or tuning process
  * @details Return the status of tunning process
+ * @details If the TUND pin is used (see setTundPin), REG20 is read only when the pin changes or every AKC_TUND_POLL_TIME ms.
  *
  * @return true    Completed
  * @return false   Not completed
  */
 bool AKC695X::isTuningComplete()
 {
-    akc595x_reg20 reg20;
-    reg20.raw = getRegister(REG20);
-    return reg20.refined.stc;
+#if AKC695X_USE_TUND
+    if (this->tundPin >= 0)
+    {
+        if (this->tundComplete)
+            return true;
+        if (this->tundEdges == this->tundSeenEdges && (millis() - this->tundLastPoll) < AKC_TUND_POLL_TIME)
+            return false; // No news from the TUND pin
+        this->tundSeenEdges = this->tundEdges;
+        this->tundLastPoll = millis();
+        this->tundComplete = akc_reg20_stc::get(getRegister(REG20));
+        return this->tundComplete;
+    }
+#endif
+
+    return akc_reg20_stc::get(getRegister(REG20));
 }
 
 /**
@@ -227,9 +745,7 @@ bool AKC695X::isTuningComplete()
  */
 uint8_t AKC695X::isCurrentModeFM()
 {
-    akc595x_reg20 reg20;
-    reg20.raw = getRegister(REG20);
-    return reg20.refined.st;
+    return akc_reg20_st::get(getRegister(REG20));
 }
 
 /**
@@ -241,14 +757,12 @@ uint8_t AKC695X::isCurrentModeFM()
  */
 uint16_t AKC695X::getCurrentChannel() {
 
-    akc595x_reg20 reg20;
     akc595x_reg21 reg21;
     uint16_t channel = 0;
 
-    reg20.raw = getRegister(REG20);
+    channel = akc_reg20_readchan::get(getRegister(REG20));
     reg21 = getRegister(REG21);
 
-    channel = reg20.refined.readchan;
     channel = channel << 8;
     channel = channel | reg21;
 
@@ -291,9 +805,7 @@ uint16_t AKC695X::channelToFrequency()
  * @return uint8_t value in dB of carrier to noise ratio.
  */
 uint8_t AKC695X::getAmCarrierNoiseRatio(){
-    akc595x_reg22 reg22;
-    reg22.raw = getRegister(REG22);
-    return reg22.refined.cnram;
+    return akc_reg22_cnram::get(getRegister(REG22));
 };
 
 /**
@@ -306,9 +818,7 @@ uint8_t AKC695X::getAmCarrierNoiseRatio(){
  * @return uint8_t current space 3kHz or 5kHz
  */
 uint8_t AKC695X::getAmCurrentSpace(){
-    akc595x_reg22 reg22;
-    reg22.raw = getRegister(REG22);
-    return reg22.refined.mode3k_f;
+    return akc_reg22_mode3k_f::get(getRegister(REG22));
 };
 
 /**
@@ -321,9 +831,7 @@ uint8_t AKC695X::getAmCurrentSpace(){
  * @return true  if stereo is detected.
  */
 bool AKC695X::isFmStereo() {
-    akc595x_reg23 reg23;
-    reg23.raw = getRegister(REG23);
-    return reg23.refined.st_dem;
+    return akc_reg23_st_dem::get(getRegister(REG23));
 }
 
 /**
@@ -337,9 +845,7 @@ bool AKC695X::isFmStereo() {
  */
 uint8_t AKC695X::getFmCarrierNoiseRatio()
 {
-    akc595x_reg23 reg23;
-    reg23.raw = getRegister(REG23);
-    return reg23.refined.cnrfm;
+    return akc_reg23_cnrfm::get(getRegister(REG23));
 };
 
 /**
@@ -350,10 +856,7 @@ uint8_t AKC695X::getFmCarrierNoiseRatio()
  * @param de  0 = 75us; 1 = 50us
  */
 void AKC695X::setFmEmphasis( uint8_t de) {
-    akc595x_reg7 reg7;
-    reg7.raw = getRegister(REG07); // Gets the current value
-    reg7.refined.de = de;          // Sets just DE attribute
-    setRegister(REG07, reg7.raw);        // Store the new REG07 content
+    setRegister(REG07, akc_reg7_de::set(getRegister(REG07), de)); // Changes just the DE attribute
 }
 
 /**
@@ -371,10 +874,7 @@ void AKC695X::setFmEmphasis( uint8_t de) {
  */
 void AKC695X::setFmStereoMono(uint8_t value)
 {
-    akc595x_reg7 reg7;
-    reg7.raw = getRegister(REG07);      // Gets the current value
-    reg7.refined.stereo_mono = value;   // Sets just the attribute
-    setRegister(REG07, reg7.raw);       // Store the new REG07 content
+    setRegister(REG07, akc_reg7_stereo_mono::set(getRegister(REG07), value)); // Changes just the attribute
 }
 
 /**
@@ -393,10 +893,7 @@ void AKC695X::setFmStereoMono(uint8_t value)
  */
 void AKC695X::setFmBandwidth(uint8_t value)
 {
-    akc595x_reg7 reg7;
-    reg7.raw = getRegister(REG07); // Gets the current value
-    reg7.refined.bw = value;      // Sets just the attribute
-    setRegister(REG07, reg7.raw);   // Store the new REG07 content
+    setRegister(REG07, akc_reg7_bw::set(getRegister(REG07), value)); // Changes just the attribute
 }
 
 /**
@@ -412,72 +909,325 @@ void AKC695X::setFmBandwidth(uint8_t value)
 
 void AKC695X::commitTune()
 {
-    akc595x_reg0 reg0;
-
-    // I know! it can be simpler and faster than this.
+    uint8_t reg0 = akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on>::encode(this->currentMode, this->tuneMute, 1); // Current mode, tune = seek = 0
 
-    reg0.raw = 0;
-    reg0.refined.fm_en = this->currentMode; // Sets to the current mode
-    reg0.refined.power_on = 1;
-    reg0.refined.tune = 1;
-
-    setRegister(REG00, reg0.raw);
-
-    reg0.refined.tune = 0;
-    reg0.refined.seek = 0;
-    reg0.refined.seekup = 0;
+#if AKC695X_USE_TRANSACTION
+    if (this->transactionOpen)
+    {
+        // Keeps the mute bit set inside the transaction. The tune process will be triggered by commitTransaction.
+        if (this->regDirty & (1 << REG00))
+            reg0 = akc_reg0_mute::set(reg0, akc_reg0_mute::get(this->regImage[REG00]));
+        setRegister(REG00, reg0);
+        this->transactionTune = true;
+        return;
+    }
+#endif
 
-    setRegister(REG00, reg0.raw);
+    setRegister(REG00, akc_reg0_tune::set(reg0, 1));
+    setRegister(REG00, reg0);
 };
 
+#if AKC695X_USE_TRANSACTION
 /**
  * @ingroup GA04
- * @brief Sets the start and end frequencies for a custom band
- * @details This method is used by setAM and setFM methods.
- * @details This will called when you set a band greater than 17 on AM mode or greater than 7 on FM mode.
- * @details You can use more than one band at a time.
+ * @brief Starts a configuration transaction
+ * @details Until commitTransaction, the methods that change the receiver configuration do not access the device.
+ * @details They change the cached register image and mark the registers they touch. The registers already known are
+ * @details read from the cached image. commitTransaction writes each touched register once.
+ * @details Outside a transaction, all methods keep writing the device immediately.
  *
- * @see akc595x_reg4, akc595x_reg5
- * @param band                  if FM, a value greater than 7. If AM, a value greater than  17. You can use more than one.
- * @param minimum_frequency     Start frequency
- * @param maximum_frequency     Final frequency
+ * @code
+ * radio.beginTransaction();
+ * radio.setFmEmphasis(1);
+ * radio.setFmStereoMono(0);
+ * radio.setFmBandwidth(3);     // REG07 is changed three times in RAM
+ * radio.setVolume(40);
+ * radio.commitTransaction();   // REG06 and REG07 are written in a single burst
+ * @endcode
+ *
+ * @see commitTransaction
  */
-void AKC695X::setCustomBand(uint16_t minimum_frequency, uint16_t maximum_frequency) {
+void AKC695X::beginTransaction()
+{
+    this->transactionOpen = true;
+}
 
-    uint16_t start_channel, end_channel;
-    akc595x_reg4 reg4; // start channel for custom band
-    akc595x_reg5 reg5; // end channel for custom band
+/**
+ * @ingroup GA04
+ * @brief Writes the registers changed since beginTransaction
+ * @details Each touched register is written once. Contiguous registers are coalesced into bursts (see writeRegisterImage).
+ * @details If some method triggered the tune process (setFrequency, setFM, setAM etc), it is triggered once after all registers are written.
+ *
+ * @see beginTransaction
+ */
+void AKC695X::commitTransaction()
+{
+    uint16_t dirty = this->regDirty;
+    uint8_t reg0 = this->regImage[REG00];
 
-    if (this->currentMode == CURRENT_MODE_FM)
+    this->transactionOpen = false;
+    this->regDirty = 0;
+
+    writeRegisterImage(this->regImage, dirty);
+
+    if (this->transactionTune)
     {
-        start_channel = (minimum_frequency - 300) * 4;
-        end_channel = (maximum_frequency - 300) * 4;
+        // Same as commitTune, but keeps the mute bit of the image
+        setRegister(REG00, akc_reg0_tune::set(reg0, 1));
+        setRegister(REG00, reg0);
+        this->transactionTune = false;
     }
-    else
+    else if (dirty & (1 << REG00))
     {
-        start_channel = minimum_frequency / ((this->currentMode3k)? 3: 5);
-        end_channel = maximum_frequency / ((this->currentMode3k)? 3: 5);
+        setRegister(REG00, reg0);
     }
+}
+#endif
 
-    reg4 = start_channel / 32;
-    reg5 = end_channel / 32;
+#if AKC695X_USE_STANDBY
+/**
+ * @ingroup GA04
+ * @brief Puts the device in low-power standby
+ * @details Mutes the audio, closes the RF and ADC paths (REG12 pd_rx and pd_adc) and turns the chip off (REG00 power_on = 0).
+ * @details The cached register image is completed before, so the receiver can be restored by resume without a full setup.
+ * @details Do not call other receiver methods while in standby. Call resume first.
+ *
+ * @see resume, akc595x_reg0, akc595x_reg12
+ */
+void AKC695X::standby()
+{
+    if (this->standbyMode)
+        return;
 
-    setRegister(REG04, reg4);
-    setRegister(REG05, reg5);
+    completeRegisterImage();
+
+    this->standbyReg00 = this->regImage[REG00];
+    this->standbyReg12 = this->regImage[REG12];
+
+    setRegister(REG12, akc_fields<akc_reg12_pd_rx, akc_reg12_pd_adc>::set(this->standbyReg12, 1, 0)); // pd_rx: 1 = closed; pd_adc: 0 = closed
+    setRegister(REG00, akc_fields<akc_reg0_power_on, akc_reg0_mute, akc_reg0_tune, akc_reg0_seek>::set(this->standbyReg00, 0, 1, 0, 0));
+
+    this->standbyMode = true;
 }
 
 /**
  * @ingroup GA04
- * @brief Sets the AKC695X to FM mode
- * @details Sets the device to FM mode. You can configure a custom FM band by setting band number greater than 7.
+ * @brief Wakes the device up from standby
+ * @details Restores the documented registers of the cached image (REG01 to REG09 and REG11 to REG13) in two bursts and retunes the
+ * @details current channel with a single tune trigger. REG10 is not documented and is not written.
+ * @details It takes a few milliseconds instead of a full setup followed by setFM or setAM.
  *
- * | FM band | N#  |Description  |
- * | --------| --- |------------ |
- * | 000     |  0  | FM1,87 ~ 108, station search space specified intervals |
- * | 001     |  1  | FM2,76 ~ 108, station search space specified intervals |
- * | 010     |  2  | FM3,70 ~ 93, with a space station search interval set |
- * | 011     |  3  | FM4,76 ~ 90, Tuning predetermined space intervals |
- * | 100     |  4  | FM5,64 ~ 88, with a space station search interval set |
+ * @see standby
+ */
+void AKC695X::resume()
+{
+    uint8_t reg0;
+
+    if (!this->standbyMode)
+        return;
+
+    this->regImage[REG12] = this->standbyReg12;
+    setRegisters(REG01, &this->regImage[REG01], REG09 - REG01 + 1);
+    setRegisters(REG11, &this->regImage[REG11], REG13 - REG11 + 1);
+
+    reg0 = akc_fields<akc_reg0_power_on, akc_reg0_seek, akc_reg0_tune>::set(this->standbyReg00, 1, 0, 0);
+    setRegister(REG00, akc_reg0_tune::set(reg0, 1)); // Trigger the tune process
+    setRegister(REG00, reg0);
+
+    this->standbyMode = false;
+}
+#endif
+
+#if AKC695X_USE_PROFILES
+/**
+ * @ingroup GA04
+ * @brief Saves the current receiver configuration in a profile
+ * @details The registers not known by the library are read in a single burst before.
+ * @details Configure the receiver by using the regular methods (setFM, setAM, setFmBandwidth, setVolume etc) and save it.
+ *
+ * @code
+ * akc_profile broadcastFM, dxSW;
+ * ...
+ * radio.setFM(0, 870, 1080, 1039, 1);
+ * radio.setFmBandwidth(1);
+ * radio.saveProfile(&broadcastFM);
+ * radio.setAM(10, 11400, 12200, 11940, 5);
+ * radio.saveProfile(&dxSW);
+ * ...
+ * radio.applyProfile(&broadcastFM);  // Writes just what is different
+ * @endcode
+ *
+ * @see applyProfile, akc_profile
+ * @param profile   profile that will receive the current configuration
+ */
+void AKC695X::saveProfile(akc_profile *profile)
+{
+    completeRegisterImage();
+    memcpy(profile->regs, this->regImage, AKC_IMAGE_SIZE);
+
+    profile->regs[REG00] = akc_fields<akc_reg0_power_on, akc_reg0_tune, akc_reg0_seek>::set(profile->regs[REG00], 1, 0, 0);
+
+    profile->mask = ((1 << AKC_IMAGE_SIZE) - 1) & ~(1 << 0x0A); // There is no information about the register 10
+    profile->mode = this->currentMode;
+    profile->band = this->currentBand;
+    profile->minimum_frequency = this->currentBandMinimumFrequency;
+    profile->maximum_frequency = this->currentBandMaximumFrequency;
+    profile->frequency = this->currentFrequency;
+    profile->step = this->currentStep;
+}
+
+/**
+ * @ingroup GA04
+ * @brief Applies a profile
+ * @details Compares the profile with the cached register image and writes only the registers that differ,
+ * @details coalescing them into bursts. If the band or the channel changes, the tune process is triggered.
+ * @details Switching between two complete configurations usually takes a single burst plus the tune trigger.
+ *
+ * @see saveProfile, akc_profile
+ * @param profile   profile to be applied
+ */
+void AKC695X::applyProfile(const akc_profile *profile)
+{
+    uint8_t reg0;
+    uint16_t dirty = 0;
+
+    for (uint8_t reg = REG00; reg < AKC_IMAGE_SIZE; reg++)
+    {
+        if ((profile->mask & (1 << reg)) && (!(this->regImageValid & (1 << reg)) || this->regImage[reg] != profile->regs[reg]))
+            dirty |= (1 << reg);
+    }
+
+    writeRegisterImage(profile->regs, dirty);
+
+    // REG00 to REG05: mode, band, channel and custom band. The device has to tune again.
+    if (dirty & ((1 << REG06) - 1))
+    {
+        reg0 = akc_reg0_power_on::set(profile->regs[REG00], 1);
+        setRegister(REG00, akc_reg0_tune::set(reg0, 1));
+        setRegister(REG00, akc_reg0_tune::set(reg0, 0));
+    }
+
+    this->currentMode = profile->mode;
+    this->currentBand = profile->band;
+    this->currentBandMinimumFrequency = profile->minimum_frequency;
+    this->currentBandMaximumFrequency = profile->maximum_frequency;
+    this->currentFrequency = profile->frequency;
+    this->currentStep = profile->step;
+    this->currentMode3k = akc_reg2_mode3k::get(profile->regs[REG02]);
+    this->currentCrystalType = akc_reg2_ref_32k_mode::get(profile->regs[REG02]);
+    this->volume = akc_reg6_volume::get(profile->regs[REG06]);
+}
+
+/**
+ * @ingroup GA04
+ * @brief Sets the band stacking registers
+ * @details Each band of your sketch has a profile (see akc_profile) that keeps its last configuration: band, custom band limits,
+ * @details frequency, bandwidth, de-emphasis, spacing, volume etc. recallBand saves the configuration of the band in use and
+ * @details applies the configuration of the new band writing only the registers that differ from the device, usually in a single burst.
+ *
+ * @code
+ * akc_profile bandStack[4];
+ * ...
+ * radio.setBandStack(bandStack, 4);
+ * ...
+ * void useBand() {
+ *   if (!radio.recallBand(bandIdx)) {
+ *     // First time on this band
+ *     radio.setFM(...);   // or setAM
+ *   }
+ * }
+ * @endcode
+ *
+ * @see recallBand, applyProfile
+ * @param slots  array declared in your sketch (one element per band)
+ * @param size   number of elements of the array
+ */
+void AKC695X::setBandStack(akc_profile *slots, uint8_t size)
+{
+    this->bandStack = slots;
+    this->bandStackSize = size;
+    this->bandStackCurrent = -1;
+    for (uint8_t i = 0; i < size; i++)
+        slots[i].mask = 0; // Empty
+}
+
+/**
+ * @ingroup GA04
+ * @brief Switches to a band of the band stacking registers
+ * @details Saves the configuration of the band in use in its element and applies the configuration stored in the element idx.
+ * @details If the element idx is empty (the band was never used), nothing is applied and false is returned. Configure the band
+ * @details with setFM or setAM. The configuration will be saved when you switch to another band.
+ *
+ * @param idx  band (element of the array, see setBandStack)
+ * @return true  the configuration of the band was applied
+ */
+bool AKC695X::recallBand(uint8_t idx)
+{
+    if (idx >= this->bandStackSize)
+        return false;
+
+    if (this->bandStackCurrent >= 0)
+        saveProfile(&this->bandStack[this->bandStackCurrent]);
+    this->bandStackCurrent = idx;
+
+    if (this->bandStack[idx].mask == 0)
+        return false;
+
+    applyProfile(&this->bandStack[idx]);
+    return true;
+}
+#endif
+
+#if AKC695X_USE_CUSTOM_BAND
+/**
+ * @ingroup GA04
+ * @brief Sets the start and end frequencies for a custom band
+ * @details This method is used by setAM and setFM methods.
+ * @details This will called when you set a band greater than 17 on AM mode or greater than 7 on FM mode.
+ * @details You can use more than one band at a time.
+ *
+ * @see akc595x_reg4, akc595x_reg5
+ * @param band                  if FM, a value greater than 7. If AM, a value greater than  17. You can use more than one.
+ * @param minimum_frequency     Start frequency
+ * @param maximum_frequency     Final frequency
+ */
+void AKC695X::setCustomBand(uint16_t minimum_frequency, uint16_t maximum_frequency) {
+
+    uint16_t start_channel, end_channel;
+    akc595x_reg4 reg4; // start channel for custom band
+    akc595x_reg5 reg5; // end channel for custom band
+
+    if (this->currentMode == CURRENT_MODE_FM)
+    {
+        start_channel = (minimum_frequency - 300) * 4;
+        end_channel = (maximum_frequency - 300) * 4;
+    }
+    else
+    {
+        start_channel = minimum_frequency / ((this->currentMode3k)? 3: 5);
+        end_channel = maximum_frequency / ((this->currentMode3k)? 3: 5);
+    }
+
+    reg4 = start_channel / 32;
+    reg5 = end_channel / 32;
+
+    setRegister(REG04, reg4);
+    setRegister(REG05, reg5);
+}
+#endif
+
+/**
+ * @ingroup GA04
+ * @brief Sets the AKC695X to FM mode
+ * @details Sets the device to FM mode. You can configure a custom FM band by setting band number greater than 7.
+ *
+ * | FM band | N#  |Description  |
+ * | --------| --- |------------ |
+ * | 000     |  0  | FM1,87 ~ 108, station search space specified intervals |
+ * | 001     |  1  | FM2,76 ~ 108, station search space specified intervals |
+ * | 010     |  2  | FM3,70 ~ 93, with a space station search interval set |
+ * | 011     |  3  | FM4,76 ~ 90, Tuning predetermined space intervals |
+ * | 100     |  4  | FM5,64 ~ 88, with a space station search interval set |
  * | 101     |  5  | TV1,56.25 ~ 91.75, station search space specified intervals |
  * | 110     |  6  | TV2, 174.75 ~ 222.25, found |
  * | 111     |  7  | sets predetermined space intervals, custom FM, station search space specified intervals |
@@ -490,7 +1240,8 @@ void AKC695X::setCustomBand(uint16_t minimum_frequency, uint16_t maximum_frequen
  */
 void AKC695X::setFM(uint8_t akc695x_fm_band, uint16_t minimum_freq, uint16_t maximum_freq, uint16_t default_frequency, uint8_t default_step)
 {
-    akc595x_reg1 reg1;
+    AKC695XTraceScope scope(this, AKC_API_SET_FM);
+
     this->currentMode = 1;
     this->currentBand = akc695x_fm_band;
     this->currentBandMinimumFrequency = minimum_freq;
@@ -498,15 +1249,14 @@ void AKC695X::setFM(uint8_t akc695x_fm_band, uint16_t minimum_freq, uint16_t max
     this->currentFrequency = default_frequency;
     this->currentStep = default_step;
 
-    reg1.raw = 0;
-    reg1.refined.fmband = akc695x_fm_band; // Selects the band will be used for FM (see fm band table)
-
-    setRegister(REG00, 0b11000000); // Sets to FM (Power On)
+    setRegister(REG00, akc_reg0_mute::set(0b11000000, this->tuneMute)); // Sets to FM (Power On)
 
+#if AKC695X_USE_CUSTOM_BAND
     if (akc695x_fm_band > 6 )
         setCustomBand(minimum_freq, maximum_freq); // Sets a custom FM band
+#endif
 
-    setRegister(REG01, reg1.raw); // Sets the FM band
+    setRegister(REG01, akc_reg1_fmband::encode(akc695x_fm_band)); // Selects the band will be used for FM (see fm band table)
 	setFrequency(default_frequency);
 }
 
@@ -547,8 +1297,7 @@ void AKC695X::setFM(uint8_t akc695x_fm_band, uint16_t minimum_freq, uint16_t max
  */
 void AKC695X::setAM(uint8_t akc695x_am_band, uint16_t minimum_freq, uint16_t maximum_freq, uint16_t default_frequency, uint8_t default_step)
 {
-
-    akc595x_reg1 reg1;
+    AKC695XTraceScope scope(this, AKC_API_SET_AM);
 
     this->currentMode = 0;
     this->currentBand = akc695x_am_band;
@@ -556,17 +1305,15 @@ void AKC695X::setAM(uint8_t akc695x_am_band, uint16_t minimum_freq, uint16_t max
     this->currentBandMaximumFrequency = maximum_freq;
     this->currentFrequency = default_frequency;
     this->currentStep = default_step;
-    
-
-    reg1.raw = 0;
-    reg1.refined.amband = akc695x_am_band; // Selects the AM band will be used (see AM band table)
 
-    setRegister(REG00, 0b10000000); // Sets to AM (Power On)
+    setRegister(REG00, akc_reg0_mute::set(0b10000000, this->tuneMute)); // Sets to AM (Power On)
 
+#if AKC695X_USE_CUSTOM_BAND
     if (akc695x_am_band > 17)
         setCustomBand(minimum_freq, maximum_freq); // Sets a custom AM band
+#endif
 
-    setRegister(REG01, reg1.raw);
+    setRegister(REG01, akc_reg1_amband::encode(akc695x_am_band)); // Selects the AM band will be used (see AM band table)
 	setFrequency(default_frequency);
 }
 
@@ -585,6 +1332,7 @@ void AKC695X::setStep(uint8_t step)
     this->currentStep = step;
 }
 
+#if AKC695X_USE_SEEK
 /**
  * @ingroup GA04
  * @brief Sets FM step for seeking.
@@ -604,9 +1352,7 @@ void AKC695X::setStep(uint8_t step)
  */
 void AKC695X::setFmSeekStep(uint8_t space)
 {
-    akc595x_reg11 reg11;
-    reg11.refined.space = (space > 3) ? 3 : space;
-    setRegister(REG11, reg11.raw);
+    setRegister(REG11, akc_reg11_space::set(getRegister(REG11), (space > 3) ? 3 : space)); // Changes just the space attribute
 }
 
 /**
@@ -632,38 +1378,57 @@ void AKC695X::setFmSeekStep(uint8_t space)
  */
 void AKC695X::seekStation(uint8_t up_down, void (*showFunc)())
 {
-    akc595x_reg0 reg0;
+    uint8_t reg0 = 0;
     long max_time = millis();
+#if AKC695X_USE_TUND
+    uint8_t edges = this->tundEdges;
+#endif
+    AKC695XTraceScope scope(this, AKC_API_SEEK_STATION);
+
+#if AKC695X_USE_TRANSACTION
+    if (this->transactionOpen)
+        commitTransaction(); // The seek process needs the device configured now
+#endif
 
     do {
-        reg0.raw = 0;
-        reg0.refined.fm_en = this->currentMode;     // Sets the current mode
-        reg0.refined.mute = 0;                      // Normal operation
-        reg0.refined.power_on = 1;                  // Power on
-        reg0.refined.tune = 0;
-        reg0.refined.seek = 1;                      // Trigger seeking process
-        reg0.refined.seekup = up_down;
-        setRegister(REG00, reg0.raw);
-        if (showFunc != NULL) {
+#if AKC695X_USE_TUND
+        // With the TUND pin, the seek process is triggered once and the bus is quiet until the pin changes
+        if (this->tundPin < 0 || !akc_reg0_seek::get(reg0))
+#endif
+        {
+            // Current mode, normal operation (mute = 0), power on and seek = 1 (triggers the seeking process)
+            reg0 = akc_fields<akc_reg0_fm_en, akc_reg0_power_on, akc_reg0_seek, akc_reg0_seekup>::encode(this->currentMode, 1, 1, up_down);
+            setRegister(REG00, reg0);
+        }
+#if AKC695X_USE_TUND
+        // With the TUND pin, the frequency is read only after a pin change
+        bool show = (this->tundPin < 0 || edges != this->tundEdges);
+        edges = this->tundEdges;
+#else
+        bool show = true;
+#endif
+        if (showFunc != NULL && show) {
             this->currentFrequency = channelToFrequency(); // gets the Current frequency in the registers 20 and 21.
             showFunc();             // Call your function that shows the frequency
         }
     } while (!isTuningComplete() && (millis() - max_time) < MAX_SEEK_TIME);
 
-   reg0.raw = 0;
-   reg0.refined.fm_en = this->currentMode;
-   reg0.refined.mute = 0;
-   reg0.refined.power_on = 1;
-   reg0.refined.tune = 0;
-   reg0.refined.seek = 0;
-   reg0.refined.seekup = up_down;
-   setRegister(REG00, reg0.raw);
+   setRegister(REG00, akc_reg0_seek::set(reg0, 0));
 
    // Updates the currentFrequency member variable to a calculated frequency based on the  channel
    // value stored in the registers 20 and 21
    this->currentFrequency = channelToFrequency();
+   if (showFunc != NULL)
+       showFunc();             // Shows the frequency found
+
+#if AKC695X_USE_SIGNAL_CACHE
+   // The station found by the seek process is a good candidate for the signal cache
+   if (this->signalCache != NULL)
+       refreshSignalCache();
+#endif
 
  }
+#endif
 
 /**
  * @ingroup GA04
@@ -679,9 +1444,8 @@ void AKC695X::seekStation(uint8_t up_down, void (*showFunc)())
  */
 void AKC695X::setFrequency(uint16_t frequency)
 {
-    uint16_t channel, tmpFreq;
-    akc595x_reg2 reg2;
-    akc595x_reg3 reg3;
+    uint16_t tmpFreq;
+    AKC695XTraceScope scope(this, AKC_API_SET_FREQUENCY);
 
     // Check the band limits
     if (frequency > this->currentBandMaximumFrequency)
@@ -691,37 +1455,67 @@ void AKC695X::setFrequency(uint16_t frequency)
     else
         tmpFreq = frequency;
 
-    reg2.raw = getRegister(REG02); // Gets the current value of the REG02
+    tuneChannel(frequencyToChannel(tmpFreq));
 
-    if (this->currentMode == 0)
-    {
-        // AM mode
-        channel = tmpFreq / ((this->currentMode3k)? 3: 5);
-        reg2.refined.channel = (channel >> 8);      // Changes just the 5 higher bits of the channel.
-        reg2.refined.ref_32k_mode = this->currentCrystalType;
-        reg2.refined.mode3k = this->currentMode3k;
-
-        reg3 = channel & 0b0000011111111;               // Sets the 8 lower bits of the channel
+    this->currentFrequency = tmpFreq;
+}
 
-        setRegister(REG03, reg3);
-        setRegister(REG02, reg2.raw);
-    }
-    else
-    {
-        // FM mode
-        channel = (tmpFreq - 300) * 4;
-        reg2.refined.channel = (channel >> 8);
-        reg2.refined.ref_32k_mode = this->currentCrystalType;
-        reg2.refined.mode3k = this->currentMode3k;
+/**
+ * @ingroup GA04
+ * @brief Tunes a channel of the current mode
+ * @details Writes the channel to REG02 and REG03 and triggers the tune process. The current frequency is not changed.
+ *
+ * @see setFrequency, frequencyToChannel
+ *
+ * @param channel  channel number (see akc595x_reg2 and akc595x_reg3)
+ */
+void AKC695X::tuneChannel(uint16_t channel)
+{
+    akc595x_reg3 reg3 = channel & 0b0000011111111;  // Sets the 8 lower bits of the channel
 
-        reg3 = channel & 0b0000011111111;
-        setRegister(REG03, reg3);
-        setRegister(REG02, reg2.raw);
-    }
+    setRegister(REG03, reg3);
+    // Changes just the 5 higher bits of the channel, the crystal and the AM channel mode of the current REG02
+    setRegister(REG02, akc_fields<akc_reg2_channel, akc_reg2_ref_32k_mode, akc_reg2_mode3k>::set(getRegister(REG02), channel >> 8, this->currentCrystalType, this->currentMode3k));
 
     commitTune();
+}
 
-    this->currentFrequency = tmpFreq;
+/**
+ * @ingroup GA04
+ * @brief Converts a frequency to the AKC695X channel number
+ * @details FM mode: Channel Freq = 25kHz * CHAN + 30MHz.
+ * @details AM mode: Channel Freq = 5kHz * CHAN (or 3kHz * CHAN if the 3K mode is selected).
+ *
+ * @see akc595x_reg2, akc595x_reg3
+ *
+ * @param frequency  frequency in the current mode unit (FM = 100kHz; AM = 1kHz)
+ * @return uint16_t  channel number
+ */
+uint16_t AKC695X::frequencyToChannel(uint16_t frequency)
+{
+    if (this->currentMode == CURRENT_MODE_FM)
+        return (frequency - 300) * 4;
+
+    return frequency / ((this->currentMode3k) ? 3 : 5);
+}
+
+/**
+ * @ingroup GA04
+ * @brief Builds the registers REG00 to REG03 that tune a frequency of the current band
+ * @details REG00 has the audio muted and the tune bit = 0. Write the four registers in a single burst and then
+ * @details REG00 with the tune bit = 1 to trigger the tune process. Used by the fast channel hops (bandscope, scanner etc).
+ *
+ * @param frequency  frequency in the current mode unit
+ * @param image      array that receives REG00 to REG03
+ */
+void AKC695X::prepareTuneImage(uint16_t frequency, uint8_t *image)
+{
+    uint16_t channel = frequencyToChannel(frequency);
+
+    image[0] = akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on>::encode(this->currentMode, 1, 1);
+    image[1] = this->regImage[REG01];
+    image[2] = akc_fields<akc_reg2_channel, akc_reg2_mode3k, akc_reg2_ref_32k_mode>::encode(channel >> 8, this->currentMode3k, this->currentCrystalType);
+    image[3] = channel & 0xFF;
 }
 
 /**
@@ -769,12 +1563,10 @@ void AKC695X::frequencyDown()
  */
 void AKC695X::setAudio(uint8_t phase_inv, uint8_t line, uint8_t volume)
 {
-    akc595x_reg6 reg6;
+    AKC695XTraceScope scope(this, AKC_API_SET_AUDIO);
 
-    this->volume = reg6.refined.volume = (volume > 63) ? 63 : volume;
-    reg6.refined.line = line;
-    reg6.refined.phase_inv = phase_inv;
-    setRegister(REG06, reg6.raw);
+    this->volume = (volume > 63) ? 63 : volume;
+    setRegister(REG06, akc_fields<akc_reg6_volume, akc_reg6_line, akc_reg6_phase_inv>::encode(this->volume, line, phase_inv));
 }
 
 /**
@@ -802,14 +1594,19 @@ void AKC695X::setAudio()
 
 void AKC695X::setVolume(uint8_t volume)
 {
-    akc595x_reg6 reg6;
-
-    reg6.raw = getRegister(REG06); // gets the current register value;
+    uint8_t reg6;
+    AKC695XTraceScope scope(this, AKC_API_SET_VOLUME);
 
     if (volume > 63)
         volume = 63;
-    this->volume = reg6.refined.volume = volume; // changes just the volume attribute
-    setRegister(REG06, reg6.raw);                // writes the new reg9 value
+    this->volume = volume;
+#if AKC695X_USE_RAMP
+    this->rampRunning = false;
+    this->softMuted = false;
+#endif
+    // The cached REG06 avoids a read in each volume step (see setVolumeUp and setVolumeDown)
+    reg6 = (this->regImageValid & (1 << REG06)) ? this->regImage[REG06] : getRegister(REG06);
+    setRegister(REG06, akc_reg6_volume::set(reg6, volume)); // changes just the volume attribute
 }
 
 /**
@@ -847,11 +1644,7 @@ void AKC695X::setVolumeDown()
  */
 void AKC695X::setVolumeControl(uint8_t type)
 {
-    akc595x_reg9 reg9;
-
-    reg9.raw = getRegister(REG09);  // gets the current register value;
-    reg9.refined.pd_adc_vol = type; // changes just the attribute pd_adc_vol
-    setRegister(REG09, reg9.raw);   // writes the new reg9 value
+    setRegister(REG09, akc_reg9_pd_adc_vol::set(getRegister(REG09), type)); // changes just the attribute pd_adc_vol
 }
 
 /**
@@ -870,18 +1663,42 @@ void AKC695X::setVolumeControl(uint8_t type)
  */
 int AKC695X::getRSSI()
 {
-    akc595x_reg24 reg24;
-    akc595x_reg27 reg27;
+    uint8_t reg24;
+    AKC695XTraceScope scope(this, AKC_API_GET_RSSI);
+
+    reg24 = getRegister(REG24);
+    return calculateRSSI(reg24, getRegister(REG27), this->currentFrequency);
+}
 
-    int factor = (this->currentMode == CURRENT_MODE_FM || this->currentFrequency > 3000) ? 103 : 123;
+/**
+ * @ingroup GA04
+ * @brief Calculates the RSSI from the registers 24 and 27
+ * @details Used by getRSSI and by the methods that read the whole status block in a single burst.
+ *
+ * @param reg24      content of the register 24
+ * @param reg27      content of the register 27
+ * @param frequency  tuned frequency (current mode unit)
+ * @return int  RSSI value (dBuV)
+ */
+int AKC695X::calculateRSSI(uint8_t reg24, uint8_t reg27, uint16_t frequency)
+{
+    int factor = (this->currentMode == CURRENT_MODE_FM || frequency > 3000) ? 103 : 123;
 
-    reg24.raw = getRegister(REG24);
-    reg27.raw = getRegister(REG27);
+    return ( factor - akc_reg27_rssi::get(reg27) - 6 * (akc_reg24_pgalevel_rf::get(reg24) + akc_reg24_pgalevel_if::get(reg24)) );
+}
 
-    // Calculates the RSSI
-    return ( factor - reg27.refined.rssi - 6 * (reg24.refined.pgalevel_rf + reg24.refined.pgalevel_if) );
+/**
+ * @ingroup GA04
+ * @brief Gets the supply voltage in millivolts
+ * @details Same as getSupplyVoltage without float math. It is available in the tiny build (see AKC695X_config.h).
+ * @return uint16_t the supply voltage in mV
+ */
+uint16_t AKC695X::getSupplyVoltageMillivolts()
+{
+    return (1800 + 50 * akc_reg25_vbat::get(getRegister(REG25)));
 }
 
+#if AKC695X_USE_FLOAT
 /**
  * @ingroup GA04
  * @brief Gets the supply voltage
@@ -890,10 +1707,9 @@ int AKC695X::getRSSI()
  */
 float AKC695X::getSupplyVoltage()
 {
-    akc595x_reg25 reg25;
-    reg25.raw = getRegister(REG25);
-    return (1.8 + 0.05 * reg25.refined.vbat);
+    return (1.8 + 0.05 * akc_reg25_vbat::get(getRegister(REG25)));
 }
+#endif
 
 
 
@@ -902,6 +1718,7 @@ float AKC695X::getSupplyVoltage()
  * @section  GA05 Format 
  */
 
+#if AKC695X_USE_FORMAT
 /**
  * @ingroup GA05
  * @brief Converts a number to a char array 
@@ -944,3 +1761,3389 @@ void AKC695X::convertToChar(uint16_t value, char *strValue, uint8_t len, uint8_t
         }
     }
 }
+#endif
+
+
+
+#if AKC695X_USE_SIGNAL_CACHE
+/**
+ * @defgroup GA06 Signal Quality Cache
+ * @section  GA06 Signal Quality Cache
+ * @details The signal quality cache keeps the last RSSI, carrier to noise ratio and stereo status measured on the channels you have visited.
+ * @details It is useful to show the known signal level as soon as the frequency changes, while a fresh measurement is still pending.
+ * @details The cache is keyed by mode, band and channel. When the cache is full, the least recently used entry is replaced.
+ */
+
+/**
+ * @ingroup GA06
+ * @brief Enables the signal quality cache
+ * @details The library does not allocate memory. You have to declare the array in your sketch. Each element uses about 9 bytes.
+ * @details Call this method with buffer = NULL to disable the cache.
+ *
+ * @code
+ * akc_signal_cache cache[8];
+ * ...
+ * radio.setSignalCache(cache, 8, 5000);  // Measurements older than 5s are considered stale.
+ * ...
+ * radio.frequencyUp();
+ * if ( radio.getCachedSignal(&signal) != AKC_CACHE_MISS ) showRSSI(signal.rssi);   // Shows the known signal level now
+ * ...
+ * radio.refreshSignalCache();                                                       // Measures it again later
+ * @endcode
+ *
+ * @param buffer    array declared in your sketch (or NULL to disable the cache)
+ * @param size      number of elements of the array (up to AKC_CACHE_MAX_SIZE; the extra elements are not used)
+ * @param max_age   time in ms that a measurement is considered fresh (default 3000ms)
+ */
+void AKC695X::setSignalCache(akc_signal_cache *buffer, uint8_t size, uint16_t max_age)
+{
+    if (size > AKC_CACHE_MAX_SIZE)
+        size = AKC_CACHE_MAX_SIZE;
+    this->signalCache = buffer;
+    this->signalCacheSize = (buffer != NULL) ? size : 0;
+    this->signalCacheMaxAge = max_age;
+    this->signalCacheCount = 0;
+}
+
+/**
+ * @ingroup GA06
+ * @brief Removes all measurements from the signal quality cache
+ */
+void AKC695X::clearSignalCache()
+{
+    this->signalCacheCount = 0;
+}
+
+/**
+ * @ingroup GA06
+ * @brief Gets the signal cache key of the current mode and band
+ * @return uint8_t  bit 7 = mode; bits 0 to 6 = band
+ */
+uint8_t AKC695X::getSignalCacheKey()
+{
+    return (this->currentMode << 7) | (this->currentBand & 0x7F);
+}
+
+/**
+ * @ingroup GA06
+ * @brief Finds a channel in the signal cache
+ * @param key       mode and band (see getSignalCacheKey)
+ * @param channel   channel number
+ * @return int8_t   index of the element or -1 if not found
+ */
+int8_t AKC695X::findSignalCache(uint8_t key, uint16_t channel)
+{
+    for (uint8_t i = 0; i < this->signalCacheCount; i++)
+    {
+        if (this->signalCache[i].key == key && this->signalCache[i].channel == channel)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @ingroup GA06
+ * @brief Moves an element to the first position of the cache (most recently used)
+ * @details The elements before idx are shifted one position. The last element of the cache is the least recently used.
+ * @param idx  index of the element
+ */
+void AKC695X::moveSignalCacheToFront(uint8_t idx)
+{
+    akc_signal_cache aux;
+
+    if (idx == 0)
+        return;
+
+    aux = this->signalCache[idx];
+    memmove(&this->signalCache[1], &this->signalCache[0], idx * sizeof(akc_signal_cache));
+    this->signalCache[0] = aux;
+}
+
+/**
+ * @ingroup GA06
+ * @brief Gets the cached signal quality of a given frequency of the current mode and band
+ *
+ * @param frequency frequency in the current mode unit
+ * @param signal    pointer to the element that will receive the cached information
+ * @return uint8_t  AKC_CACHE_MISS, AKC_CACHE_STALE or AKC_CACHE_FRESH
+ */
+uint8_t AKC695X::getCachedSignal(uint16_t frequency, akc_signal_cache *signal)
+{
+    int8_t idx;
+
+    if (this->signalCacheCount == 0)
+        return AKC_CACHE_MISS;
+
+    idx = findSignalCache(getSignalCacheKey(), frequencyToChannel(frequency));
+    if (idx < 0)
+        return AKC_CACHE_MISS;
+
+    moveSignalCacheToFront(idx);
+    *signal = this->signalCache[0];
+
+    return ((millis() - signal->timestamp) > this->signalCacheMaxAge) ? AKC_CACHE_STALE : AKC_CACHE_FRESH;
+}
+
+/**
+ * @ingroup GA06
+ * @brief Gets the cached signal quality of the current frequency
+ * @details It does not access the device. Use it to show the signal level right after changing the frequency.
+ *
+ * @see setSignalCache, refreshSignalCache
+ *
+ * @param signal    pointer to the element that will receive the cached information
+ * @return uint8_t  AKC_CACHE_MISS, AKC_CACHE_STALE or AKC_CACHE_FRESH
+ */
+uint8_t AKC695X::getCachedSignal(akc_signal_cache *signal)
+{
+    return getCachedSignal(this->currentFrequency, signal);
+}
+
+/**
+ * @ingroup GA06
+ * @brief Measures the signal quality of the current channel and stores it in the cache
+ * @details Reads the RSSI, carrier to noise ratio and the stereo status from the device.
+ * @details If the cache is full, the least recently used element is replaced.
+ *
+ * @see getRSSI, getFmCarrierNoiseRatio, getAmCarrierNoiseRatio, isFmStereo
+ */
+void AKC695X::refreshSignalCache()
+{
+    uint8_t reg23;
+    int rssi;
+    AKC695XTraceScope scope(this, AKC_API_SIGNAL_CACHE);
+
+    if (this->signalCacheSize == 0)
+        return;
+
+    rssi = getRSSI();
+    if (this->currentMode == CURRENT_MODE_FM)
+    {
+        reg23 = getRegister(REG23); // CNR and stereo status in one read
+        storeSignalCache(getSignalCacheKey(), frequencyToChannel(this->currentFrequency), rssi, akc_reg23_cnrfm::get(reg23), akc_reg23_st_dem::get(reg23));
+    }
+    else
+        storeSignalCache(getSignalCacheKey(), frequencyToChannel(this->currentFrequency), rssi, getAmCarrierNoiseRatio(), 0);
+}
+
+/**
+ * @ingroup GA06
+ * @brief Stores a measurement in the signal cache
+ * @details The element becomes the most recently used. If the cache is full, the least recently used element is replaced.
+ *
+ * @param key      mode and band (see getSignalCacheKey)
+ * @param channel  channel number
+ * @param rssi     RSSI in dBuV
+ * @param cnr      carrier to noise ratio in dB
+ * @param stereo   1 = FM stereo detected
+ */
+void AKC695X::storeSignalCache(uint8_t key, uint16_t channel, int rssi, uint8_t cnr, uint8_t stereo)
+{
+    akc_signal_cache *entry;
+    int8_t idx;
+
+    if (this->signalCacheSize == 0)
+        return;
+
+    idx = findSignalCache(key, channel);
+    if (idx < 0)
+    {
+        // New element. Uses a free position or replaces the least recently used one.
+        if (this->signalCacheCount < this->signalCacheSize)
+            this->signalCacheCount++;
+        idx = this->signalCacheCount - 1;
+    }
+    moveSignalCacheToFront(idx);
+
+    entry = &this->signalCache[0];
+    entry->key = key;
+    entry->channel = channel;
+    entry->rssi = rssi;
+    entry->cnr = cnr;
+    entry->stereo = stereo;
+    entry->timestamp = millis();
+}
+#endif
+
+
+#if AKC695X_USE_BAND_PLAN
+/**
+ * @defgroup GA08 Band Plan
+ * @section  GA08 Band Plan
+ * @details The native FM and AM bands of the AKC695X, with their limits, default steps and spacing, are stored in flash (PROGMEM).
+ * @details The table is sorted by mode and minimum frequency. So, the band that contains a given frequency is found by a binary search.
+ * @details Your sketch does not need a band table in RAM for the native bands.
+ * @details Values based on the setFM and setAM band tables. The FM band 7 is the custom FM band (30 to 230MHz).
+ */
+
+#define AKC_PLAN_FM (1 << 7)
+
+static const akc_band_plan bandPlan[] PROGMEM = {
+    {0, 150, 285, 3, 1},                // LW
+    {1, 520, 1710, 5, 0},               // MW1
+    {3, 520, 1710, 10, 0},              // MW3
+    {17, 520, 1730, 5, 0},              // MW4
+    {2, 522, 1620, 9, 1},               // MW2
+    {5, 3200, 4100, 5, 0},              // SW2
+    {4, 4700, 10000, 5, 0},             // SW1
+    {6, 4700, 5600, 5, 0},              // SW3
+    {7, 5700, 6400, 5, 0},              // SW4
+    {8, 6800, 7600, 5, 0},              // SW5
+    {9, 9200, 10000, 5, 0},             // SW6
+    {10, 11400, 12200, 5, 0},           // SW7
+    {16, 11400, 17900, 5, 0},           // SW13
+    {11, 13500, 14300, 5, 0},           // SW8
+    {12, 15000, 15900, 5, 0},           // SW9
+    {13, 17400, 17900, 5, 0},           // SW10
+    {14, 18900, 19700, 5, 0},           // SW11
+    {15, 21400, 21900, 5, 0},           // SW12
+    {AKC_PLAN_FM | 7, 300, 2300, 1, 2}, // Custom FM
+    {AKC_PLAN_FM | 5, 563, 917, 1, 2},  // TV1
+    {AKC_PLAN_FM | 4, 640, 880, 1, 2},  // FM5
+    {AKC_PLAN_FM | 2, 700, 930, 1, 2},  // FM3
+    {AKC_PLAN_FM | 1, 760, 1080, 1, 2}, // FM2
+    {AKC_PLAN_FM | 3, 760, 900, 1, 2},  // FM4
+    {AKC_PLAN_FM | 0, 870, 1080, 1, 2}, // FM1
+    {AKC_PLAN_FM | 6, 1748, 2222, 1, 2} // TV2
+};
+
+#define AKC_PLAN_SIZE (sizeof(bandPlan) / sizeof(akc_band_plan))
+#define AKC_PLAN_FIRST_FM 18 // Index of the first FM band
+
+/**
+ * @ingroup GA08
+ * @brief Gets the number of bands of the band plan
+ * @return uint8_t number of bands (FM and AM)
+ */
+uint8_t AKC695X::getBandPlanSize()
+{
+    return AKC_PLAN_SIZE;
+}
+
+/**
+ * @ingroup GA08
+ * @brief Copies a band plan entry from flash to RAM
+ * @details Use it to iterate the band plan without copying the whole table into RAM.
+ *
+ * @code
+ * akc_band_plan band;
+ * for (uint8_t i = 0; i < radio.getBandPlanSize(); i++) {
+ *     radio.getBandPlan(i, &band);
+ *     ...
+ * }
+ * @endcode
+ *
+ * @param idx   entry index (0 to getBandPlanSize() - 1)
+ * @param band  pointer to the element that will receive the entry
+ */
+void AKC695X::getBandPlan(uint8_t idx, akc_band_plan *band)
+{
+    memcpy_P(band, &bandPlan[idx], sizeof(akc_band_plan));
+}
+
+/**
+ * @ingroup GA08
+ * @brief Gets the band plan index of a native band
+ *
+ * @param mode      AKC_FM or AKC_AM
+ * @param band      FM band (0 to 7) or AM band (0 to 17)
+ * @return int8_t   entry index or -1 if it is not a native band
+ */
+int8_t AKC695X::getBandPlanIndex(uint8_t mode, uint8_t band)
+{
+    uint8_t key = (mode << 7) | band;
+
+    for (uint8_t i = 0; i < AKC_PLAN_SIZE; i++)
+    {
+        if (pgm_read_byte(&bandPlan[i].mode_band) == key)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @ingroup GA08
+ * @brief Finds the native band that contains a given frequency
+ * @details A binary search finds the last band that starts at or below the frequency. As some bands overlap
+ * @details (SW1 contains SW3 to SW6, for example), the bands before it are checked and the narrowest one is returned.
+ *
+ * @code
+ * int8_t idx = radio.findBandPlan(AKC_AM, 9600);  // SW6, 9.2 ~ 10MHz
+ * radio.useBandPlan(idx, 9600);
+ * @endcode
+ *
+ * @param mode       AKC_FM or AKC_AM
+ * @param frequency  frequency (FM: 100kHz units; AM: kHz)
+ * @return int8_t    entry index or -1 if no band contains the frequency
+ */
+int8_t AKC695X::findBandPlan(uint8_t mode, uint16_t frequency)
+{
+    int8_t first = (mode == AKC_FM) ? AKC_PLAN_FIRST_FM : 0;
+    int8_t low = first;
+    int8_t high = (mode == AKC_FM) ? AKC_PLAN_SIZE : AKC_PLAN_FIRST_FM;
+    int8_t middle, found = -1;
+    uint16_t width, narrowest = 0xFFFF;
+
+    // Upper bound: first band that starts above the frequency
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if (pgm_read_word(&bandPlan[middle].minimum_frequency) <= frequency)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    // The bands before the upper bound start at or below the frequency. Going back, the minimum frequency decreases, so
+    // the width of a band that contains the frequency is at least (frequency - minimum). When it reaches the narrowest
+    // band found, no earlier band can be narrower.
+    for (int8_t i = low - 1; i >= first; i--)
+    {
+        uint16_t minimum = pgm_read_word(&bandPlan[i].minimum_frequency);
+        uint16_t maximum = pgm_read_word(&bandPlan[i].maximum_frequency);
+        if ((frequency - minimum) >= narrowest)
+            break;
+        if (maximum < frequency)
+            continue;
+        width = maximum - minimum;
+        if (width < narrowest)
+        {
+            narrowest = width;
+            found = i;
+        }
+    }
+    return found;
+}
+
+/**
+ * @ingroup GA08
+ * @brief Switches the receiver to a band of the band plan
+ * @details Sets the AM channel spacing, calls setFM or setAM with the band limits and default step and,
+ * @details on FM, sets the seek space.
+ *
+ * @param idx        entry index (see findBandPlan and getBandPlanIndex)
+ * @param frequency  frequency to tune. If it is out of the band, the minimum frequency of the band is used.
+ */
+void AKC695X::useBandPlan(uint8_t idx, uint16_t frequency)
+{
+    akc_band_plan band;
+
+    getBandPlan(idx, &band);
+
+    if (frequency < band.minimum_frequency || frequency > band.maximum_frequency)
+        frequency = band.minimum_frequency;
+
+    if (band.mode_band & AKC_PLAN_FM)
+    {
+        setFM(band.mode_band & 0x7F, band.minimum_frequency, band.maximum_frequency, frequency, band.step);
+#if AKC695X_USE_SEEK
+        setFmSeekStep(band.space);
+#endif
+    }
+    else
+    {
+        setMode3k(band.space);
+        setAM(band.mode_band, band.minimum_frequency, band.maximum_frequency, frequency, band.step);
+    }
+}
+#endif
+
+
+#if AKC695X_USE_SCHEDULER
+/**
+ * @defgroup GA09 Task Scheduler
+ * @section  GA09 Task Scheduler
+ * @details AKC695XScheduler replaces the hand-rolled millis() comparisons of the loop function by a table of tasks.
+ * @code
+ * AKC695XScheduler scheduler;
+ * akc_task tasks[3];
+ * int8_t saveTask;
+ *
+ * void setup() {
+ *   ...
+ *   scheduler.setup(tasks, 3);
+ *   scheduler.addTask(showRSSI, 500, 0, 1);          // Every 500ms, priority 1
+ *   scheduler.addTask(disableCommands, 2000);        // Every 2s
+ *   saveTask = scheduler.addTask(saveAllReceiverInformation, 0, 10000); // One-shot
+ * }
+ *
+ * void loop() {
+ *   if (encoderCount != 0) {
+ *      ...
+ *      scheduler.scheduleTask(saveTask, 10000);      // Saves the status after 10s of inactivity
+ *   }
+ *   scheduler.run();
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA09
+ * @brief Sets the task array
+ * @details All tasks are removed.
+ *
+ * @param buffer  array declared in your sketch
+ * @param size    number of elements of the array
+ */
+void AKC695XScheduler::setup(akc_task *buffer, uint8_t size)
+{
+    this->tasks = buffer;
+    this->size = size;
+    for (uint8_t i = 0; i < size; i++)
+        this->tasks[i].callback = NULL;
+}
+
+/**
+ * @ingroup GA09
+ * @brief Adds a task
+ *
+ * @param callback     function that does the job
+ * @param period       period in ms. 0 = one-shot task (see scheduleTask)
+ * @param first_delay  time in ms until the first run
+ * @param priority     when more than one task is due, the highest priority runs first
+ * @param deadline     maximum lateness in ms. A run after it is counted as a miss.
+ * @return int8_t      task id or -1 if there is no free task
+ */
+int8_t AKC695XScheduler::addTask(void (*callback)(), uint16_t period, uint16_t first_delay, uint8_t priority, uint16_t deadline)
+{
+    for (uint8_t i = 0; i < this->size; i++)
+    {
+        akc_task *task = &this->tasks[i];
+        if (task->callback != NULL)
+            continue;
+        task->callback = callback;
+        task->period = period;
+        task->priority = priority;
+        task->deadline = deadline;
+        task->due = millis() + first_delay;
+        task->active = 1;
+        task->runs = task->misses = task->maxJitter = 0;
+        task->sumJitter = 0;
+        return i;
+    }
+    return -1;
+}
+
+/**
+ * @ingroup GA09
+ * @brief Removes a task
+ * @param id  task id (see addTask)
+ */
+void AKC695XScheduler::removeTask(int8_t id)
+{
+    if (id >= 0 && id < this->size)
+        this->tasks[id].callback = NULL;
+}
+
+/**
+ * @ingroup GA09
+ * @brief Schedules the next run of a task
+ * @details Useful to (re)start one-shot tasks. Calling it again before the task runs postpones it.
+ *
+ * @param id          task id (see addTask)
+ * @param delay_time  time in ms until the next run
+ */
+void AKC695XScheduler::scheduleTask(int8_t id, uint16_t delay_time)
+{
+    if (id < 0 || id >= this->size)
+        return;
+    this->tasks[id].due = millis() + delay_time;
+    this->tasks[id].active = 1;
+}
+
+/**
+ * @ingroup GA09
+ * @brief Runs the most urgent due task
+ * @details Call it in your loop function. It runs at most one task per call: the due task with the highest priority
+ * @details (or the most late one if they have the same priority). Periodic tasks keep their phase. If a periodic task
+ * @details is late more than one period, the runs lost are skipped.
+ *
+ * @return int8_t  id of the task that has run or -1 if no task was due
+ */
+int8_t AKC695XScheduler::run()
+{
+    uint32_t now = millis();
+    uint32_t late, selectedLate = 0;
+    int8_t selected = -1;
+    akc_task *task;
+
+    for (uint8_t i = 0; i < this->size; i++)
+    {
+        task = &this->tasks[i];
+        if (task->callback == NULL || !task->active || (int32_t)(now - task->due) < 0)
+            continue;
+        late = now - task->due;
+        if (selected < 0 || task->priority > this->tasks[selected].priority ||
+            (task->priority == this->tasks[selected].priority && late > selectedLate))
+        {
+            selected = i;
+            selectedLate = late;
+        }
+    }
+
+    if (selected < 0)
+        return -1;
+
+    task = &this->tasks[selected];
+    if (selectedLate > 0xFFFF)
+        selectedLate = 0xFFFF;
+    if (task->runs == 0xFFFF)
+    {
+        // Halves both counters. The average lateness is kept.
+        task->runs >>= 1;
+        task->sumJitter >>= 1;
+    }
+    task->runs++;
+    task->sumJitter += selectedLate;
+    if (selectedLate > task->maxJitter)
+        task->maxJitter = selectedLate;
+    if (selectedLate > task->deadline && task->misses < 0xFFFF)
+        task->misses++;
+
+    if (task->period == 0)
+        task->active = 0;
+    else
+    {
+        task->due += task->period;
+        if ((int32_t)(now - task->due) >= 0) // Too late. Skips the lost runs.
+            task->due = now + task->period;
+    }
+
+    task->callback();
+    return selected;
+}
+
+/**
+ * @ingroup GA09
+ * @brief Gets the average lateness of a task
+ * @param id          task id (see addTask)
+ * @return uint16_t   average lateness in ms (0 if the id is invalid)
+ */
+uint16_t AKC695XScheduler::getAverageJitter(int8_t id)
+{
+    if (id < 0 || id >= this->size)
+        return 0;
+    akc_task *task = &this->tasks[id];
+    return (task->runs > 0) ? task->sumJitter / task->runs : 0;
+}
+
+/**
+ * @ingroup GA09
+ * @brief Clears the statistics of all tasks
+ */
+void AKC695XScheduler::resetStatistics()
+{
+    for (uint8_t i = 0; i < this->size; i++)
+    {
+        this->tasks[i].runs = this->tasks[i].misses = this->tasks[i].maxJitter = 0;
+        this->tasks[i].sumJitter = 0;
+    }
+}
+#endif
+
+
+#if AKC695X_USE_ASYNC
+/**
+ * @defgroup GA10 Non-blocking Transaction Queue
+ * @section  GA10 Non-blocking Transaction Queue
+ * @details setRegister and getRegister block the MCU during the I2C transfer and during the time the device needs after it
+ * @details (AKC_WRITE_GUARD_TIME and AKC_READ_GUARD_TIME). Most of the blocking time is this guard time.
+ * @details The transaction queue stores register writes and reads and processQueue runs them one by one, when the guard time of the
+ * @details previous transaction is over. So, the MCU can decode the encoder and update the display while the receiver is being programmed.
+ * @details The Wire library owns the TWI interrupt. So, the queue is processed by calling processQueue in your loop function.
+ * @code
+ * akc_transaction txQueue[8];
+ * void setup() {
+ *   ...
+ *   radio.setTransactionQueue(txQueue, 8, onRegisterRead);
+ * }
+ * void loop() {
+ *   if (encoderCount != 0) {
+ *     radio.queueFrequency(radio.getFrequency() + step);  // Returns immediately
+ *     showFrequency();
+ *   }
+ *   radio.processQueue();
+ * }
+ * @endcode
+ * @details Do not mix queued and blocking register access while the queue is not empty. Call flushQueue before.
+ */
+
+/**
+ * @ingroup GA10
+ * @brief Sets the transaction queue
+ *
+ * @param buffer    array declared in your sketch (or NULL to disable the queue)
+ * @param size      number of elements of the array
+ * @param callback  Optional. Function called when a queued read completes. It receives the register and its content.
+ */
+void AKC695X::setTransactionQueue(akc_transaction *buffer, uint8_t size, void (*callback)(uint8_t reg, uint8_t value))
+{
+    this->queue = buffer;
+    this->queueSize = (buffer != NULL) ? size : 0;
+    this->queueHead = this->queueCount = 0;
+    this->queueReadPending = false;
+    this->queueAttempts = 0;
+    this->queueCallback = callback;
+}
+
+/**
+ * @ingroup GA10
+ * @brief Adds a transaction to the queue
+ * @param op_reg    bit 7 = read; bits 0 to 6 = register
+ * @param value     value to be written
+ * @return true     if the transaction was queued; false if the queue is full
+ */
+bool AKC695X::enqueue(uint8_t op_reg, uint8_t value)
+{
+    akc_transaction *transaction;
+
+    if (this->queueCount >= this->queueSize)
+        return false;
+
+    transaction = &this->queue[(this->queueHead + this->queueCount) % this->queueSize];
+    transaction->op_reg = op_reg;
+    transaction->value = value;
+    this->queueCount++;
+    return true;
+}
+
+/**
+ * @ingroup GA10
+ * @brief Queues a register write
+ * @details The cached register image is updated when the register is actually written.
+ *
+ * @param reg       register
+ * @param value     value to be written
+ * @return true     if the transaction was queued; false if the queue is full
+ */
+bool AKC695X::queueRegister(uint8_t reg, uint8_t value)
+{
+    return enqueue(reg & 0x7F, value);
+}
+
+/**
+ * @ingroup GA10
+ * @brief Queues a register read
+ * @details The result is delivered to the callback function (see setTransactionQueue) and stored in the cached register image.
+ *
+ * @param reg       register
+ * @return true     if the transaction was queued; false if the queue is full
+ */
+bool AKC695X::queueRead(uint8_t reg)
+{
+    return enqueue(0x80 | reg, 0);
+}
+
+/**
+ * @ingroup GA10
+ * @brief Queues the transactions to tune a frequency
+ * @details Non-blocking version of setFrequency. The registers are computed from the receiver status kept by the library
+ * @details (no register is read): REG03, REG02 and the tune trigger (REG00). It needs 4 free elements in the queue.
+ *
+ * @see setFrequency
+ * @param frequency frequency you want to set to
+ * @return true     if the transactions were queued; false if the queue has no room for them
+ */
+bool AKC695X::queueFrequency(uint16_t frequency)
+{
+    uint8_t reg0;
+    uint8_t mute;
+    uint16_t channel;
+
+    if ((this->queueSize - this->queueCount) < 4)
+        return false;
+
+    // Check the band limits
+    if (frequency > this->currentBandMaximumFrequency)
+        frequency = this->currentBandMinimumFrequency;
+    else if (frequency < this->currentBandMinimumFrequency)
+        frequency = this->currentBandMaximumFrequency;
+
+    channel = frequencyToChannel(frequency);
+    // Keeps the audio muted if it is muted now (or during a band change, see tuneMute)
+    mute = this->tuneMute || ((this->regImageValid & (1 << REG00)) && akc_reg0_mute::get(this->regImage[REG00]));
+    reg0 = akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on>::encode(this->currentMode, mute, 1);
+
+    enqueue(REG03, channel & 0xFF);
+    enqueue(REG02, akc_fields<akc_reg2_channel, akc_reg2_mode3k, akc_reg2_ref_32k_mode>::encode(channel >> 8, this->currentMode3k, this->currentCrystalType));
+    enqueue(REG00, akc_reg0_tune::set(reg0, 1));
+    enqueue(REG00, reg0);
+
+    this->currentFrequency = frequency;
+    return true;
+}
+
+/**
+ * @ingroup GA10
+ * @brief Processes the transaction queue
+ * @details Runs at most one I2C transfer and only if the guard time of the previous one is over. It never waits.
+ * @details A read takes two calls: the first one sends the register address and the second one reads the data.
+ *
+ * @return uint8_t  number of transactions still waiting (0 = idle)
+ */
+uint8_t AKC695X::processQueue()
+{
+    akc_transaction *transaction;
+    uint8_t reg, value, result;
+
+    if (this->queueCount == 0 || (int32_t)(micros() - this->queueReady) < 0)
+        return this->queueCount;
+
+    transaction = &this->queue[this->queueHead];
+    reg = transaction->op_reg & 0x7F;
+
+    if (!(transaction->op_reg & 0x80))
+    {
+        result = busWrite(reg, &transaction->value, 1);
+        this->queueReady = micros() + AKC_WRITE_GUARD_TIME;
+        if (result == AKC_BUS_OK)
+            registerWritten(reg, transaction->value);
+    }
+    else if (!this->queueReadPending)
+    {
+        result = busWrite(reg, NULL, 0);
+        this->queueReady = micros() + AKC_WRITE_GUARD_TIME;
+        if (result == AKC_BUS_OK)
+        {
+            this->queueReadPending = true;
+            return this->queueCount; // The data will be read in the next call
+        }
+    }
+    else
+    {
+        result = busRead(&value, 1);
+        this->queueReady = micros() + AKC_READ_GUARD_TIME;
+        this->queueReadPending = false;
+        if (result == AKC_BUS_OK)
+        {
+            registerRead(reg, value);
+            if (this->queueCallback != NULL)
+                this->queueCallback(reg, value);
+        }
+    }
+
+    // A failed transaction is repeated in the next calls (see setBusRetries). Then, it is dropped.
+    if (result != AKC_BUS_OK && busRetry(result, this->queueAttempts++))
+        return this->queueCount;
+    this->queueAttempts = 0;
+
+    this->queueHead = (this->queueHead + 1) % this->queueSize;
+    this->queueCount--;
+    return this->queueCount;
+}
+
+/**
+ * @ingroup GA10
+ * @brief Processes all queued transactions
+ * @details Blocks until the queue is empty and the guard time of the last transaction is over.
+ * @details Call it before using the blocking methods (setRegister, getRegister, setFM etc).
+ */
+void AKC695X::flushQueue()
+{
+    while (processQueue() > 0 || (int32_t)(micros() - this->queueReady) < 0)
+        ;
+}
+#endif
+
+
+#if AKC695X_USE_LATENCY
+/**
+ * @defgroup GA11 Tune Latency Histograms
+ * @section  GA11 Tune Latency Histograms
+ * @details The library can measure how long the device takes to tune. It timestamps the tune or seek trigger (REG00 write),
+ * @details the first read of REG20 with STC = 1 and the first read of REG20 with tuned = 1. The latencies are accumulated in
+ * @details log2 histograms per mode, band and kind of trigger (see akc_latency_histogram).
+ * @details Use the histograms to adjust the timing of your sketch (for example, how long to wait before reading the RSSI) or to
+ * @details detect a degraded antenna or crystal in a deployed receiver.
+ * @details The device status is not read by the library. So, the resolution is the interval between two reads of REG20 in your
+ * @details sketch (isTuningComplete, isTuned, getStatus, seekStation etc).
+ * @code
+ * akc_latency_histogram latency[6];
+ * void setup() {
+ *   ...
+ *   radio.setLatencyHistogram(latency, 6);
+ * }
+ * ...
+ * radio.dumpLatencyHistogram(&Serial);
+ * @endcode
+ */
+
+/**
+ * @ingroup GA11
+ * @brief Enables the tune latency histograms
+ * @details Each mode, band and kind of trigger (tune or seek) uses one element of the table. When the table is full, the new
+ * @details combinations are not measured. Call this method with table = NULL to stop measuring.
+ *
+ * @see akc_latency_histogram, dumpLatencyHistogram
+ *
+ * @param table  array declared in your sketch (or NULL)
+ * @param size   number of elements of the array
+ */
+void AKC695X::setLatencyHistogram(akc_latency_histogram *table, uint8_t size)
+{
+    this->latencyTable = (size > 0) ? table : NULL;
+    this->latencySize = size;
+    clearLatencyHistogram();
+}
+
+/**
+ * @ingroup GA11
+ * @brief Clears all histograms of the latency table
+ */
+void AKC695X::clearLatencyHistogram()
+{
+    this->latencyState = 0;
+    if (this->latencyTable == NULL)
+        return;
+    memset(this->latencyTable, 0, sizeof(akc_latency_histogram) * this->latencySize);
+    for (uint8_t i = 0; i < this->latencySize; i++)
+        this->latencyTable[i].key = 0xFF;
+}
+
+/**
+ * @ingroup GA11
+ * @brief Finds the histogram of a key
+ *
+ * @param key  see akc_latency_histogram
+ * @param add  if true and the key was not found, uses a free element
+ * @return akc_latency_histogram*  NULL if not found (or the table is full)
+ */
+akc_latency_histogram *AKC695X::findLatencyHistogram(uint8_t key, bool add)
+{
+    akc_latency_histogram *free_element = NULL;
+
+    for (uint8_t i = 0; i < this->latencySize; i++)
+    {
+        if (this->latencyTable[i].key == key)
+            return &this->latencyTable[i];
+        if (this->latencyTable[i].key == 0xFF && free_element == NULL)
+            free_element = &this->latencyTable[i];
+    }
+
+    if (add && free_element != NULL)
+        free_element->key = key;
+    return (add) ? free_element : NULL;
+}
+
+/**
+ * @ingroup GA11
+ * @brief Updates the latency measurement with a register operation
+ * @details Called by the register access methods. A write to REG00 that sets the tune or the seek bit starts a measurement.
+ * @details The seek bit is written many times during the seek process. Just the first write (0 -> 1) is a trigger.
+ *
+ * @param op     AKC_TRACE_WRITE or AKC_TRACE_READ
+ * @param reg    register
+ * @param value  value written or read
+ */
+void AKC695X::observeLatency(uint8_t op, uint8_t reg, uint8_t value)
+{
+    akc_latency_histogram *histogram;
+    uint32_t elapsed;
+    uint8_t bucket, rising;
+
+    if (this->latencyTable == NULL)
+        return;
+
+    if (op == AKC_TRACE_WRITE)
+    {
+        if (reg != REG00)
+            return;
+        rising = value & (uint8_t)~this->latencyLastReg00 & akc_fields<akc_reg0_tune, akc_reg0_seek>::mask; // tune or seek 0 -> 1
+        this->latencyLastReg00 = value;
+        if (rising)
+        {
+            if (this->latencyState == 2 && (histogram = findLatencyHistogram(this->latencyKey, false)) != NULL && histogram->untuned < 0xFFFF)
+                histogram->untuned++; // The previous tune did not catch a station
+            this->latencyKey = (this->currentMode << 7) | (akc_reg0_seek::get(value) << 6) | (this->currentBand & 0x3F);
+            this->latencyStart = micros();
+            this->latencyState = 1;
+        }
+        return;
+    }
+
+    if (reg != REG20 || this->latencyState == 0)
+        return;
+
+    if ((this->latencyState == 1 && !akc_reg20_stc::get(value)) || (this->latencyState == 2 && !akc_reg20_tuned::get(value)))
+        return;
+
+    elapsed = (micros() - this->latencyStart) / 1000;
+    for (bucket = 0; elapsed > 0 && bucket < (AKC_LATENCY_BUCKETS - 1); bucket++)
+        elapsed >>= 1;
+
+    if ((histogram = findLatencyHistogram(this->latencyKey, true)) == NULL)
+    {
+        this->latencyState = 0; // The table is full
+        return;
+    }
+
+    if (this->latencyState == 1)
+    {
+        if (histogram->stc[bucket] < 0xFFFF)
+            histogram->stc[bucket]++;
+        this->latencyStart = micros();
+        this->latencyState = 2;
+        if (!akc_reg20_tuned::get(value))
+            return;
+        bucket = 0; // STC and tuned in the same read
+    }
+
+    if (histogram->tuned[bucket] < 0xFFFF)
+        histogram->tuned[bucket]++;
+    this->latencyState = 0;
+}
+
+/**
+ * @ingroup GA11
+ * @brief Gets the histogram of a mode, band and kind of trigger
+ *
+ * @param mode  1 = FM; 0 = AM
+ * @param band  band number (see setFM and setAM)
+ * @param seek  true = seek latencies; false = tune latencies (default)
+ * @return akc_latency_histogram*  NULL if there is no measurement
+ */
+akc_latency_histogram *AKC695X::getLatencyHistogram(uint8_t mode, uint8_t band, bool seek)
+{
+    return findLatencyHistogram((mode << 7) | (seek << 6) | (band & 0x3F), false);
+}
+
+/**
+ * @ingroup GA11
+ * @brief Gets a percentile of a histogram
+ * @details Example: getLatencyPercentile(h, AKC_LATENCY_STC, 95) = 16 means that 95% of the tunes took less than 16ms to complete.
+ *
+ * @param histogram  see getLatencyHistogram
+ * @param phase      AKC_LATENCY_STC or AKC_LATENCY_TUNED
+ * @param percent    1 to 100
+ * @return uint16_t  upper limit of the bucket in ms (0 if there is no sample; 65535 if the percentile is in the last bucket)
+ */
+uint16_t AKC695X::getLatencyPercentile(const akc_latency_histogram *histogram, uint8_t phase, uint8_t percent)
+{
+    const uint16_t *buckets;
+    uint32_t total = 0, count = 0;
+    uint8_t i;
+
+    if (histogram == NULL)
+        return 0;
+    buckets = (phase == AKC_LATENCY_STC) ? histogram->stc : histogram->tuned;
+
+    for (i = 0; i < AKC_LATENCY_BUCKETS; i++)
+        total += buckets[i];
+    if (total == 0)
+        return 0;
+
+    for (i = 0; i < (AKC_LATENCY_BUCKETS - 1); i++)
+    {
+        count += buckets[i];
+        if (count * 100 >= total * percent)
+            break;
+    }
+    return (i < (AKC_LATENCY_BUCKETS - 1)) ? (1 << i) : 0xFFFF;
+}
+
+/**
+ * @ingroup GA11
+ * @brief Writes the histograms to a stream as CSV lines
+ * @details One line per histogram and phase: mode,band,trigger,phase,untuned,bucket 0, ..., bucket 11
+ *
+ * @code
+ * mode,band,trigger,phase,untuned,<1,<2,<4,<8,<16,<32,<64,<128,<256,<512,<1024,>=1024
+ * FM,0,tune,stc,2,0,0,0,1,14,3,0,0,0,0,0,0
+ * FM,0,tune,tuned,2,9,4,1,0,0,0,0,0,0,0,0,0
+ * @endcode
+ *
+ * @param output  stream (for example: &Serial)
+ */
+void AKC695X::dumpLatencyHistogram(Print *output)
+{
+    akc_latency_histogram *histogram;
+    uint8_t i, phase;
+
+    output->print(F("mode,band,trigger,phase,untuned"));
+    for (i = 0; i < (AKC_LATENCY_BUCKETS - 1); i++)
+    {
+        output->print(F(",<"));
+        output->print(1U << i);
+    }
+    output->println(F(",>=1024"));
+
+    for (i = 0; i < this->latencySize; i++)
+    {
+        histogram = &this->latencyTable[i];
+        if (histogram->key == 0xFF)
+            continue;
+        for (phase = AKC_LATENCY_STC; phase <= AKC_LATENCY_TUNED; phase++)
+        {
+            output->print((histogram->key & 0x80) ? F("FM,") : F("AM,"));
+            output->print(histogram->key & 0x3F);
+            output->print((histogram->key & 0x40) ? F(",seek,") : F(",tune,"));
+            output->print((phase == AKC_LATENCY_STC) ? F("stc,") : F("tuned,"));
+            output->print(histogram->untuned);
+            for (uint8_t b = 0; b < AKC_LATENCY_BUCKETS; b++)
+            {
+                output->print(',');
+                output->print((phase == AKC_LATENCY_STC) ? histogram->stc[b] : histogram->tuned[b]);
+            }
+            output->println();
+        }
+    }
+}
+#endif
+
+
+#if AKC695X_USE_TUND
+/**
+ * @defgroup GA12 TUND Pin
+ * @section  GA12 TUND Pin
+ * @details The TUND pin of the device drives the tuning lamp (REG13 st_led = 0). When it is connected to an interrupt capable
+ * @details pin of the MCU, the library learns about the end of a tune or seek process from the pin changes instead of reading
+ * @details REG20 over and over. isTuningComplete reads REG20 only when the pin changes or every AKC_TUND_POLL_TIME ms (a tune
+ * @details or seek that does not catch a station does not change the pin). seekStation triggers the seek process once and, when it has
+ * @details a showFunc, reads the frequency only after a pin change and at the end of the seek.
+ * @details The TUND pin is an open drain output. The library enables the internal pull-up resistor of the MCU pin.
+ * @code
+ * #define TUND_PIN 2   // Arduino UNO/Nano: pins 2 or 3
+ * ...
+ * radio.setup(RESET_PIN);
+ * radio.setTundPin(TUND_PIN);
+ * @endcode
+ */
+
+AKC695X *AKC695X::tundInstance = NULL;
+
+/**
+ * @ingroup GA12
+ * @brief TUND pin interrupt service routine
+ * @details Just counts the pin changes. The device is read later, outside the interrupt.
+ */
+void AKC695X::tundInterrupt()
+{
+    if (tundInstance != NULL)
+        tundInstance->tundEdges++;
+}
+
+/**
+ * @ingroup GA12
+ * @brief Uses the TUND pin to detect the end of the tune and seek processes
+ * @details Configures the TUND pin of the device as tuning lamp and attaches an interrupt to the MCU pin.
+ * @details Just one AKC695X instance can use the TUND pin.
+ *
+ * @param pin  MCU pin connected to the TUND pin. It must support external interrupts (digitalPinToInterrupt).
+ *             Use -1 to go back to the REG20 polling.
+ */
+void AKC695X::setTundPin(int8_t pin)
+{
+    if (this->tundPin >= 0)
+        detachInterrupt(digitalPinToInterrupt(this->tundPin));
+
+    this->tundPin = pin;
+    this->tundComplete = false;
+    if (pin < 0)
+    {
+        tundInstance = NULL;
+        return;
+    }
+
+    setRegister(REG13, akc_reg13_st_led::set(getRegister(REG13), 0)); // TUND pin is the tuning lamp
+
+    tundInstance = this;
+    this->tundSeenEdges = this->tundUserEdges = this->tundEdges;
+    pinMode(pin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(pin), tundInterrupt, CHANGE);
+}
+
+/**
+ * @ingroup GA12
+ * @brief Checks if the tuned state changed
+ * @details Returns true once after each TUND pin change. Use it to update the display (tuned indicator, RSSI)
+ * @details only when something changed, without reading the device.
+ *
+ * @return true  the TUND pin changed since the last call
+ */
+bool AKC695X::isTundChanged()
+{
+    uint8_t edges = this->tundEdges;
+    bool changed = (edges != this->tundUserEdges);
+    this->tundUserEdges = edges;
+    return changed;
+}
+
+/**
+ * @ingroup GA12
+ * @brief Restarts the TUND pin detection when a tune or seek process is triggered
+ * @details Called by the register write methods.
+ *
+ * @param reg    register written
+ * @param value  value written
+ */
+void AKC695X::tundTrigger(uint8_t reg, uint8_t value)
+{
+    if (this->tundPin < 0 || reg != REG00)
+        return;
+    if (value & akc_fields<akc_reg0_tune, akc_reg0_seek>::mask)
+    {
+        this->tundComplete = false;
+        this->tundSeenEdges = this->tundEdges;
+        this->tundLastPoll = millis();
+    }
+}
+#endif
+
+
+#if AKC695X_USE_BANDSCOPE
+/**
+ * @defgroup GA13 Bandscope
+ * @section  GA13 Bandscope
+ * @details The bandscope sweeps a window of frequencies around the current frequency over and over and stores the signal level of each
+ * @details frequency (bin) in an array declared in your sketch. The sweep is non-blocking: processBandscope runs one I2C transaction
+ * @details per call, when the guard time of the previous one is over. Each bin costs three transactions: a burst write of REG00 to REG03
+ * @details (tune bit = 0 and the new channel), the tune trigger and a burst read of the status block (REG20 to REG27).
+ * @details At the end of each sweep, a binary frame with the bins that changed is sent to a stream (see sendBandscopeFrame).
+ * @details Use the host tool extras/tools/akc695x_bandscope.cpp to show the frames as a waterfall.
+ * @details The audio is muted while the bandscope runs. stopBandscope tunes the current frequency again.
+ * @code
+ * uint8_t scope[64];
+ * ...
+ * radio.startBandscope(scope, 64, 1, &Serial);   // 64 bins, 100kHz apart (FM)
+ * ...
+ * void loop() {
+ *   radio.processBandscope();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA13
+ * @brief Starts the bandscope
+ * @details The window is centered on the current frequency and kept inside the current band limits. If the band is narrower
+ * @details than the window, the number of bins is reduced to the channels of the band (see getBandscopeBins).
+ *
+ * @see processBandscope, sendBandscopeFrame
+ *
+ * @param buffer  array declared in your sketch with one element per bin
+ * @param bins    number of bins (1 to 255)
+ * @param step    frequency step between two bins (current mode unit, see setFrequency)
+ * @param output  stream that receives a frame at the end of each sweep (for example: &Serial) or NULL
+ * @return false  if the parameters are invalid
+ */
+bool AKC695X::startBandscope(uint8_t *buffer, uint8_t bins, uint8_t step, Print *output)
+{
+    uint16_t span;
+    int32_t start;
+
+    if (buffer == NULL || bins == 0 || step == 0)
+        return false;
+
+    // The window cannot be wider than the band
+    if ((uint32_t)(bins - 1) * step > (uint16_t)(this->currentBandMaximumFrequency - this->currentBandMinimumFrequency))
+        bins = (this->currentBandMaximumFrequency - this->currentBandMinimumFrequency) / step + 1;
+    span = (bins - 1) * step;
+
+    completeRegisterImage(); // REG01 is written in each tune
+    this->bandscopeMute = akc_reg0_mute::get(this->regImage[REG00]);
+
+    this->bandscopeBuffer = buffer;
+    this->bandscopeBins = bins;
+    this->bandscopeStep = step;
+    this->bandscopeOutput = output;
+
+    // Centers the window and keeps it inside the band
+    start = (int32_t)this->currentFrequency - (bins / 2) * step;
+    if ((start + span) > this->currentBandMaximumFrequency)
+        start = (int32_t)this->currentBandMaximumFrequency - span;
+    if (start < this->currentBandMinimumFrequency)
+        start = this->currentBandMinimumFrequency;
+    this->bandscopeStart = start;
+
+    memset(buffer, 0x80, bins); // All bins are sent in the first frame
+    this->bandscopeBin = 0;
+    this->bandscopeReady = micros();
+    this->bandscopeState = 1;
+    return true;
+}
+
+/**
+ * @ingroup GA13
+ * @brief Stops the bandscope and tunes the current frequency again
+ * @details The audio is muted again if it was muted before startBandscope.
+ */
+void AKC695X::stopBandscope()
+{
+    if (this->bandscopeState == 0)
+        return;
+    this->bandscopeState = 0;
+    while ((int32_t)(micros() - this->bandscopeReady) < 0)
+        ;
+    // The sweep can stop with tune = 1 and mute = 1. The tune bit has to go to 0 first, so the tune trigger of setFrequency is an edge.
+    setRegister(REG00, akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on>::encode(this->currentMode, this->bandscopeMute, 1));
+    this->tuneMute = this->bandscopeMute;
+    setFrequency(this->currentFrequency);
+    this->tuneMute = 0;
+}
+
+/**
+ * @ingroup GA13
+ * @brief Writes registers without waiting for the guard time
+ * @details The guard time is controlled by bandscopeReady.
+ *
+ * @param reg     first register
+ * @param values  register contents
+ * @param count   number of registers
+ * @return true if the device received the values. If not, the same step is repeated in the next call.
+ */
+bool AKC695X::bandscopeWrite(uint8_t reg, const uint8_t *values, uint8_t count)
+{
+    bool ok = (busWrite(reg, values, count) == AKC_BUS_OK);
+
+    this->bandscopeReady = micros() + AKC_WRITE_GUARD_TIME;
+    for (uint8_t i = 0; ok && i < count; i++)
+        registerWritten(reg + i, values[i]);
+    return ok;
+}
+
+/**
+ * @ingroup GA13
+ * @brief Runs the next step of the bandscope sweep
+ * @details Call this method as often as possible in your loop function. It returns immediately if the device is not ready.
+ *
+ * @return true  a sweep was completed (and a frame was sent if an output stream was given)
+ */
+bool AKC695X::processBandscope()
+{
+    uint8_t values[8];
+    uint16_t frequency;
+    int16_t level;
+    uint8_t old_level;
+
+    if (this->bandscopeState == 0 || (int32_t)(micros() - this->bandscopeReady) < 0)
+        return false;
+
+    frequency = getBandscopeFrequency(this->bandscopeBin);
+
+    switch (this->bandscopeState)
+    {
+    case 1: // REG00 (tune = 0), REG01 and the channel (REG02 and REG03) in a single burst
+        prepareTuneImage(frequency, values);
+        if (bandscopeWrite(REG00, values, 4))
+            this->bandscopeState = 2;
+        return false;
+    case 2: // Tune trigger
+        values[0] = akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on, akc_reg0_tune>::encode(this->currentMode, 1, 1, 1);
+        if (!bandscopeWrite(REG00, values, 1))
+            return false;
+        this->bandscopeTrigger = micros();
+        this->bandscopeReady = this->bandscopeTrigger + AKC_BANDSCOPE_SETTLE_TIME;
+        this->bandscopeState = 3;
+        return false;
+    case 3: // Status block address
+        if (bandscopeWrite(REG20, NULL, 0))
+            this->bandscopeState = 4;
+        return false;
+    }
+
+    // Status block (REG20 to REG27)
+    this->bandscopeState = 3;
+    this->bandscopeReady = micros() + AKC_READ_GUARD_TIME;
+    if (busRead(values, 8) != AKC_BUS_OK)
+        return false; // Reads the status again
+    for (uint8_t i = 0; i < 8; i++)
+        registerRead(REG20 + i, values[i]);
+
+    if (!akc_reg20_stc::get(values[0]) && (micros() - this->bandscopeTrigger) < (MAX_TUNE_TIME * 1000UL))
+    {
+        this->bandscopeState = 3; // Not tuned yet. Reads the status again.
+        return false;
+    }
+
+    level = calculateRSSI(values[REG24 - REG20], values[REG27 - REG20], frequency);
+    if (level < 0)
+        level = 0;
+    else if (level > 127)
+        level = 127;
+
+    old_level = this->bandscopeBuffer[this->bandscopeBin] & 0x7F;
+    if (abs(level - old_level) >= AKC_BANDSCOPE_THRESHOLD)
+        this->bandscopeBuffer[this->bandscopeBin] = 0x80 | level;
+
+    this->bandscopeState = 1;
+    if (++this->bandscopeBin < this->bandscopeBins)
+        return false;
+
+    this->bandscopeBin = 0;
+    if (this->bandscopeOutput != NULL)
+        sendBandscopeFrame(this->bandscopeOutput);
+    this->bandscopeSeq++;
+    return true;
+}
+
+/**
+ * @ingroup GA13
+ * @brief Sends the bins that changed since the previous frame
+ * @details Consecutive changed bins with the same level are sent as a single run (run-length encoding).
+ * @details A frame without runs is sent if nothing changed. The frame format is:
+ *
+ * | Bytes | Content                                                              |
+ * | ----- | -------------------------------------------------------------------- |
+ * | 1     | AKC_BANDSCOPE_SYNC (0xB5)                                             |
+ * | 1     | sweep sequence number                                                |
+ * | 2     | frequency of the bin 0 (little-endian)                               |
+ * | 1     | frequency step between two bins                                      |
+ * | 1     | number of bins                                                       |
+ * | 1     | number of runs                                                       |
+ * | 3 * n | runs: first bin, number of bins, level (dBuV)                        |
+ * | 1     | XOR of all bytes after the sync byte                                 |
+ *
+ * @param output  stream (for example: &Serial)
+ */
+void AKC695X::sendBandscopeFrame(Print *output)
+{
+    uint8_t header[6], run[3];
+    uint8_t checksum = 0, runs = 0, i, first;
+
+    // Counts the runs
+    for (i = 0; i < this->bandscopeBins; i++)
+    {
+        if ((this->bandscopeBuffer[i] & 0x80) && (i == 0 || this->bandscopeBuffer[i] != this->bandscopeBuffer[i - 1]))
+            runs++;
+    }
+
+    header[0] = this->bandscopeSeq;
+    header[1] = this->bandscopeStart & 0xFF;
+    header[2] = this->bandscopeStart >> 8;
+    header[3] = this->bandscopeStep;
+    header[4] = this->bandscopeBins;
+    header[5] = runs;
+
+    output->write(AKC_BANDSCOPE_SYNC);
+    for (i = 0; i < 6; i++)
+    {
+        output->write(header[i]);
+        checksum ^= header[i];
+    }
+
+    for (first = 0; first < this->bandscopeBins; first = i)
+    {
+        for (i = first + 1; i < this->bandscopeBins && this->bandscopeBuffer[i] == this->bandscopeBuffer[first]; i++)
+            ;
+        if (!(this->bandscopeBuffer[first] & 0x80))
+            continue;
+        run[0] = first;
+        run[1] = i - first;
+        run[2] = this->bandscopeBuffer[first] & 0x7F;
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            output->write(run[j]);
+            checksum ^= run[j];
+        }
+        for (uint8_t j = first; j < i; j++)
+            this->bandscopeBuffer[j] &= 0x7F;
+    }
+    output->write(checksum);
+}
+#endif
+
+
+#if AKC695X_USE_LINK
+/**
+ * @defgroup GA14 Binary Serial Control Protocol
+ * @section  GA14 Binary Serial Control Protocol
+ * @details AKC695XLink lets a host (PC control software) drive the receiver at high rate without the overhead of text commands.
+ * @details Each request frame carries a batch of commands (for example: band, frequency and volume). The commands are checked
+ * @details before any of them runs. So, a batch is executed entirely or not at all. When AKC695X_USE_TRANSACTION is enabled, the batch
+ * @details runs inside a configuration transaction and each register is written once (see beginTransaction).
+ * @details Every request is answered with a reply frame that has the result and the receiver status, built from a single burst
+ * @details read of the status block (REG20 to REG27).
+ * @details If the host sends the same sequence number again (the reply was lost), the commands are not executed again. Just the reply is sent.
+ * @details The host side is implemented by extras/tools/akc695x_link.h (Linux).
+ *
+ * Request frame:
+ *
+ * | Bytes | Content                                                                     |
+ * | ----- | --------------------------------------------------------------------------- |
+ * | 1     | AKC_LINK_SYNC (0xA6)                                                        |
+ * | 1     | sequence number                                                             |
+ * | 1     | payload length (0 to AKC_LINK_MAX_PAYLOAD)                                  |
+ * | n     | commands: command id followed by its arguments (16 bits are little-endian)  |
+ * | 1     | CRC-8 (polynomial 0x07) of the sequence number, length and payload          |
+ *
+ * Reply frame: AKC_LINK_SYNC, the request sequence number, length (13), payload and CRC-8. The payload is:
+ * result (AKC_LINK_OK, AKC_LINK_CRC_ERROR or AKC_LINK_BAD_COMMAND), mode and band (bit 7 = 1 FM), frequency (2), volume and REG20 to REG27.
+ *
+ * @code
+ * AKC695X radio;
+ * AKC695XLink link;
+ *
+ * void setup() {
+ *   Serial.begin(115200);
+ *   radio.setup(RESET_PIN);
+ *   ...
+ *   link.setup(&radio, &Serial);
+ * }
+ *
+ * void loop() {
+ *   link.process();
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA14
+ * @brief Sets the receiver and the stream used by the link
+ *
+ * @param radio  receiver controlled by the link
+ * @param port   stream of the requests and replies (for example: &Serial)
+ */
+void AKC695XLink::setup(AKC695X *radio, Stream *port)
+{
+    this->radio = radio;
+    this->port = port;
+    this->received = 0;
+    this->lastValid = false;
+    this->frameCount = this->errorCount = 0;
+}
+
+/**
+ * @ingroup GA14
+ * @brief Calculates the CRC-8 (polynomial 0x07) of a block
+ *
+ * @param data    block
+ * @param length  number of bytes
+ * @param crc     initial value (or the CRC of the previous blocks)
+ * @return uint8_t CRC
+ */
+uint8_t AKC695XLink::crc8(const uint8_t *data, uint8_t length, uint8_t crc)
+{
+    for (uint8_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @ingroup GA14
+ * @brief Receives and runs the requests
+ * @details Call this method in your loop function. It reads the bytes available in the stream and never waits for more bytes.
+ * @details An incomplete frame is discarded if the next byte does not arrive in AKC_LINK_TIMEOUT ms.
+ *
+ * @return true  a request was answered
+ */
+bool AKC695XLink::process()
+{
+    int c;
+    uint8_t seq, length, result;
+
+    if (this->received > 0 && (millis() - this->lastByteTime) > AKC_LINK_TIMEOUT)
+        this->received = 0;
+
+    while ((c = this->port->read()) >= 0)
+    {
+        this->lastByteTime = millis();
+
+        if (this->received == 0)
+        {
+            if (c == AKC_LINK_SYNC)
+                this->received = 1;
+            continue;
+        }
+
+        this->frame[this->received - 1] = c;
+        this->received++;
+
+        if (this->received == 3 && this->frame[1] > AKC_LINK_MAX_PAYLOAD)
+        {
+            this->received = 0; // Invalid length. Waits for the next sync byte
+            this->errorCount++;
+            continue;
+        }
+        if (this->received < 4 || this->received < (this->frame[1] + 4))
+            continue;
+
+        // The whole frame was received
+        this->received = 0;
+        seq = this->frame[0];
+        length = this->frame[1];
+
+        if (crc8(this->frame, length + 2) != this->frame[length + 2])
+        {
+            this->errorCount++;
+            reply(seq, AKC_LINK_CRC_ERROR);
+            return true;
+        }
+
+        if (this->lastValid && seq == this->lastSeq)
+            result = this->lastResult; // Retransmission. The commands were executed before
+        else
+        {
+            result = execute(&this->frame[2], length);
+            if (result == AKC_LINK_OK)
+                this->frameCount++;
+            else
+                this->errorCount++;
+            this->lastSeq = seq;
+            this->lastResult = result;
+            this->lastValid = true;
+        }
+        reply(seq, result);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @ingroup GA14
+ * @brief Checks and runs the commands of a request
+ *
+ * @param payload  commands
+ * @param length   number of bytes of the payload
+ * @return uint8_t AKC_LINK_OK or AKC_LINK_BAD_COMMAND
+ */
+uint8_t AKC695XLink::execute(const uint8_t *payload, uint8_t length)
+{
+    const uint8_t *p;
+    uint8_t size;
+
+    // Checks the whole batch first (command id and number of arguments)
+    for (p = payload; p < (payload + length); p += size + 1)
+    {
+        switch (*p)
+        {
+        case AKC_LINK_SET_FM:
+        case AKC_LINK_SET_AM:
+            size = 8;
+            break;
+        case AKC_LINK_SET_FREQUENCY:
+        case AKC_LINK_SET_REGISTER:
+            size = 2;
+            break;
+        case AKC_LINK_SET_VOLUME:
+#if AKC695X_USE_SEEK
+        case AKC_LINK_SEEK: // Without seekStation, it is a bad command
+#endif
+            size = 1;
+            break;
+        case AKC_LINK_FREQUENCY_UP:
+        case AKC_LINK_FREQUENCY_DOWN:
+        case AKC_LINK_STATUS:
+            size = 0;
+            break;
+        default:
+            return AKC_LINK_BAD_COMMAND;
+        }
+        if ((p + size + 1) > (payload + length))
+            return AKC_LINK_BAD_COMMAND;
+    }
+
+#if AKC695X_USE_TRANSACTION
+    this->radio->beginTransaction();
+#endif
+    for (p = payload; p < (payload + length); p++)
+    {
+        switch (*p)
+        {
+        case AKC_LINK_SET_FM:
+            this->radio->setFM(p[1], p[2] | (p[3] << 8), p[4] | (p[5] << 8), p[6] | (p[7] << 8), p[8]);
+            p += 8;
+            break;
+        case AKC_LINK_SET_AM:
+            this->radio->setAM(p[1], p[2] | (p[3] << 8), p[4] | (p[5] << 8), p[6] | (p[7] << 8), p[8]);
+            p += 8;
+            break;
+        case AKC_LINK_SET_FREQUENCY:
+            this->radio->setFrequency(p[1] | (p[2] << 8));
+            p += 2;
+            break;
+        case AKC_LINK_SET_REGISTER:
+            this->radio->setRegister(p[1], p[2]);
+            p += 2;
+            break;
+        case AKC_LINK_SET_VOLUME:
+            this->radio->setVolume(p[1]);
+            p++;
+            break;
+#if AKC695X_USE_SEEK
+        case AKC_LINK_SEEK:
+            this->radio->seekStation(p[1]);
+            p++;
+            break;
+#endif
+        case AKC_LINK_FREQUENCY_UP:
+            this->radio->frequencyUp();
+            break;
+        case AKC_LINK_FREQUENCY_DOWN:
+            this->radio->frequencyDown();
+            break;
+        }
+    }
+#if AKC695X_USE_TRANSACTION
+    this->radio->commitTransaction();
+#endif
+    return AKC_LINK_OK;
+}
+
+/**
+ * @ingroup GA14
+ * @brief Sends a reply frame with the result and the receiver status
+ *
+ * @param seq     sequence number of the request
+ * @param result  AKC_LINK_OK, AKC_LINK_CRC_ERROR or AKC_LINK_BAD_COMMAND
+ */
+void AKC695XLink::reply(uint8_t seq, uint8_t result)
+{
+    uint8_t data[15];
+    uint16_t frequency = this->radio->getFrequency();
+
+    data[0] = seq;
+    data[1] = 13;
+    data[2] = result;
+    data[3] = (this->radio->getCurrentMode() << 7) | (this->radio->getCurrentBand() & 0x7F);
+    data[4] = frequency & 0xFF;
+    data[5] = frequency >> 8;
+    data[6] = this->radio->getVolume();
+    this->radio->getRegisters(REG20, &data[7], 8); // Status block in a single transaction
+
+    this->port->write(AKC_LINK_SYNC);
+    this->port->write(data, 15);
+    this->port->write(crc8(data, 15));
+}
+#endif
+
+
+#if AKC695X_USE_STATUS
+/**
+ * @defgroup GA15 Shared Status
+ * @section  GA15 Shared Status
+ * @details When several parts of a sketch (display, logger, scanner, remote control) need the receiver status, each one
+ * @details usually reads the device on its own. getStatus coalesces these reads: the status block (REG20 to REG27) is read in a
+ * @details single burst and the snapshot is shared until it gets older than the max age of the caller or a register is written.
+ * @details The parts that just want to know about changes subscribe a callback. The callbacks are called when a new read
+ * @details shows a different frequency, tuned, stereo or STC state, or an RSSI or CNR change of at least setStatusThreshold dB.
+ * @code
+ * void onStatus(const akc_status *status) {
+ *   showRSSI(status->rssi);
+ *   showStereo(status->stereo);
+ * }
+ *
+ * void setup() {
+ *   ...
+ *   radio.subscribeStatus(onStatus);
+ * }
+ *
+ * void loop() {
+ *   radio.getStatus(200);  // Reads the device at most every 200ms
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA15
+ * @brief Gets the receiver status
+ * @details Reads the status block in a single burst if the last snapshot is older than max_age ms or if a register was
+ * @details written after it. Otherwise, returns the last snapshot without accessing the device.
+ *
+ * @param max_age  maximum age (in ms) of the snapshot. 0 = always reads the device
+ * @return const akc_status*  status snapshot
+ */
+const akc_status *AKC695X::getStatus(uint16_t max_age)
+{
+    akc_status previous;
+    uint8_t reg20, reg23;
+    uint16_t channel;
+
+    if (this->statusValid && (millis() - this->status.timestamp) < max_age)
+        return &this->status;
+
+    previous = this->status;
+    getRegisters(REG20, this->status.regs, 8);
+
+    reg20 = this->status.regs[0];
+    reg23 = this->status.regs[REG23 - REG20];
+
+    // Same calculation of channelToFrequency
+    channel = (akc_reg20_readchan::get(reg20) << 8) | this->status.regs[REG21 - REG20];
+    if (this->currentMode == CURRENT_MODE_FM)
+        this->status.frequency = (channel >> 2) + 300;
+    else
+        this->status.frequency = channel * ((this->currentMode3k) ? 3 : 5);
+
+    this->status.rssi = calculateRSSI(this->status.regs[REG24 - REG20], this->status.regs[REG27 - REG20], this->status.frequency);
+    this->status.cnr = (this->currentMode == CURRENT_MODE_FM) ? akc_reg23_cnrfm::get(reg23) : akc_reg22_cnram::get(this->status.regs[REG22 - REG20]);
+    this->status.stc = akc_reg20_stc::get(reg20);
+    this->status.tuned = akc_reg20_tuned::get(reg20);
+    this->status.stereo = akc_reg23_st_dem::get(reg23);
+    this->status.timestamp = millis();
+    this->statusValid = true;
+
+    if (isStatusChanged(&previous))
+    {
+        for (uint8_t i = 0; i < AKC_STATUS_SUBSCRIBERS; i++)
+            if (this->statusSubscribers[i] != NULL)
+                this->statusSubscribers[i](&this->status);
+    }
+    return &this->status;
+}
+
+/**
+ * @ingroup GA15
+ * @brief Compares the last status snapshot with a previous one
+ *
+ * @param previous  previous snapshot
+ * @return true  the change has to be notified to the subscribers
+ */
+bool AKC695X::isStatusChanged(const akc_status *previous)
+{
+    return previous->frequency != this->status.frequency || previous->stc != this->status.stc ||
+           previous->tuned != this->status.tuned || previous->stereo != this->status.stereo ||
+           abs(previous->rssi - this->status.rssi) >= this->statusThreshold ||
+           abs(previous->cnr - this->status.cnr) >= this->statusThreshold;
+}
+
+/**
+ * @ingroup GA15
+ * @brief Registers a function that is called when the status changes
+ * @details The callback is called from getStatus. Do not call getStatus from the callback.
+ *
+ * @param callback  function of your sketch
+ * @return int8_t   subscriber id (see unsubscribeStatus) or -1 if there are already AKC_STATUS_SUBSCRIBERS subscribers
+ */
+int8_t AKC695X::subscribeStatus(void (*callback)(const akc_status *status))
+{
+    for (uint8_t i = 0; i < AKC_STATUS_SUBSCRIBERS; i++)
+    {
+        if (this->statusSubscribers[i] == NULL)
+        {
+            this->statusSubscribers[i] = callback;
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @ingroup GA15
+ * @brief Removes a status change callback
+ *
+ * @param id  subscriber id returned by subscribeStatus
+ */
+void AKC695X::unsubscribeStatus(int8_t id)
+{
+    if (id >= 0 && id < AKC_STATUS_SUBSCRIBERS)
+        this->statusSubscribers[id] = NULL;
+}
+#endif
+
+
+#if AKC695X_USE_SCANNER
+/**
+ * @defgroup GA16 Preset Scanner
+ * @section  GA16 Preset Scanner
+ * @details The scanner cycles through a list of presets (memories) that can be in different bands. It dwells on each
+ * @details preset and stops when the signal beats the squelch (RSSI and CNR). It resumes when the signal stays below the squelch
+ * @details for the hang time. The scanner is non-blocking: call processScanner in your loop function.
+ * @details While a preset is being measured, the registers of the next one are already prepared. If the next preset is in the
+ * @details same band, the hop is just a burst write of REG00 to REG03 and the tune trigger (no band setup). The audio is muted
+ * @details while the scanner hops.
+ * @code
+ * const akc_preset presets[] = {
+ *   {0x80 | 0, 1039},   // FM1 (band 0), 103.9MHz
+ *   {0x80 | 0, 1061},
+ *   {1, 810},           // MW1 (band 1), 810kHz
+ * };
+ *
+ * void onScanner(uint8_t index, bool active) {
+ *   ...
+ * }
+ *
+ * void setup() {
+ *   ...
+ *   radio.startScanner(presets, 3, 150, 25, 10, 3000, onScanner);
+ * }
+ *
+ * void loop() {
+ *   radio.processScanner();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA16
+ * @brief Starts the preset scanner
+ * @details Do not change the frequency, band or mode while the scanner is running (see stopScanner).
+ *
+ * @param list      presets declared in your sketch
+ * @param size      number of presets
+ * @param dwell     time (in ms) on each inactive preset
+ * @param min_rssi  squelch: minimum RSSI (dBuV)
+ * @param min_cnr   squelch: minimum CNR (dB)
+ * @param hang      time (in ms) without signal before resuming the scan (default 2000)
+ * @param callback  function called when the scanner stops on a preset (active = true) and when it leaves it (active = false). Optional.
+ */
+void AKC695X::startScanner(const akc_preset *list, uint8_t size, uint16_t dwell, int8_t min_rssi, uint8_t min_cnr, uint16_t hang, void (*callback)(uint8_t index, bool active))
+{
+    if (list == NULL || size == 0)
+        return;
+
+    this->scanList = list;
+    this->scanSize = size;
+    this->scanDwell = dwell;
+    this->scanMinRssi = min_rssi;
+    this->scanMinCnr = min_cnr;
+    this->scanHang = hang;
+    this->scanCallback = callback;
+    this->scanIndex = 0;
+
+    completeRegisterImage(); // REG01 is written in each hop
+    prepareScannerHop(0);
+    this->scanState = AKC_SCAN_HOP;
+}
+
+/**
+ * @ingroup GA16
+ * @brief Stops the scanner on the current preset
+ * @details The audio is unmuted.
+ */
+void AKC695X::stopScanner()
+{
+    if (this->scanState == AKC_SCAN_STOPPED)
+        return;
+    this->scanState = AKC_SCAN_STOPPED;
+    setScannerMute(false);
+}
+
+/**
+ * @ingroup GA16
+ * @brief Prepares the registers of the next preset
+ * @details Called after each hop, while the current preset is being measured.
+ *
+ * @param index  next preset
+ */
+void AKC695X::prepareScannerHop(uint8_t index)
+{
+    const akc_preset *preset = &this->scanList[index];
+
+    this->scanNext = index;
+    this->scanSameBand = (preset->mode_band == ((this->currentMode << 7) | this->currentBand)) && (this->regImageValid & (1 << REG01));
+    if (this->scanSameBand)
+        prepareTuneImage(preset->frequency, this->scanImage); // Otherwise, the band setup is done by useBandPlan
+}
+
+/**
+ * @ingroup GA16
+ * @brief Tunes the next preset and prepares the registers of the following one
+ */
+void AKC695X::scannerHop()
+{
+    const akc_preset *preset = &this->scanList[this->scanNext];
+    int8_t idx;
+
+    if (this->scanSameBand)
+    {
+        setRegisters(REG00, this->scanImage, 4);
+        setRegister(REG00, akc_reg0_tune::set(this->scanImage[0], 1));
+        this->currentFrequency = preset->frequency;
+    }
+    else if ((idx = getBandPlanIndex(preset->mode_band >> 7, preset->mode_band & 0x7F)) >= 0)
+    {
+        this->tuneMute = 1; // The band setup keeps the audio muted
+        useBandPlan(idx, preset->frequency);
+        this->tuneMute = 0;
+    }
+    else
+    {
+        // The band of this preset is not in the band plan. Skips it.
+        prepareScannerHop((this->scanNext + 1) % this->scanSize);
+        return;
+    }
+
+    this->scanIndex = this->scanNext;
+    this->scanTime = this->scanPoll = millis();
+    this->scanState = AKC_SCAN_LISTEN;
+    prepareScannerHop((this->scanIndex + 1) % this->scanSize);
+}
+
+/**
+ * @ingroup GA16
+ * @brief Measures the signal of the current preset
+ * @details Reads the status block (REG20 to REG27) in a single burst.
+ *
+ * @return true  the tune process is complete and the signal beats the squelch
+ */
+bool AKC695X::isScannerSignal()
+{
+    uint8_t values[8];
+
+    getRegisters(REG20, values, 8);
+    this->scanPoll = millis();
+
+    return akc_reg20_stc::get(values[0]) &&
+           calculateRSSI(values[REG24 - REG20], values[REG27 - REG20], this->currentFrequency) >= this->scanMinRssi &&
+           ((this->currentMode == CURRENT_MODE_FM) ? akc_reg23_cnrfm::get(values[REG23 - REG20]) : akc_reg22_cnram::get(values[REG22 - REG20])) >= this->scanMinCnr;
+}
+
+/**
+ * @ingroup GA16
+ * @brief Mutes or unmutes the audio without triggering the tune process
+ *
+ * @param on  true = mute
+ */
+void AKC695X::setScannerMute(bool on)
+{
+    setRegister(REG00, akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on>::encode(this->currentMode, on, 1));
+}
+
+/**
+ * @ingroup GA16
+ * @brief Runs the scanner
+ * @details Call this method as often as possible in your loop function. Most calls return without accessing the device.
+ *
+ * @return uint8_t  scanner state: AKC_SCAN_STOPPED, AKC_SCAN_HOP, AKC_SCAN_LISTEN or AKC_SCAN_HOLD
+ */
+uint8_t AKC695X::processScanner()
+{
+    uint32_t now = millis();
+
+    switch (this->scanState)
+    {
+    case AKC_SCAN_HOP:
+        scannerHop();
+        break;
+
+    case AKC_SCAN_LISTEN:
+        if ((now - this->scanTime) < AKC_SCAN_SETTLE_TIME || (now - this->scanPoll) < AKC_SCAN_SETTLE_TIME)
+            break;
+        if (isScannerSignal())
+        {
+            this->scanTime = now;
+            this->scanState = AKC_SCAN_HOLD;
+            setScannerMute(false);
+            if (this->scanCallback != NULL)
+                this->scanCallback(this->scanIndex, true);
+        }
+        else if ((now - this->scanTime) >= this->scanDwell)
+            this->scanState = AKC_SCAN_HOP;
+        break;
+
+    case AKC_SCAN_HOLD:
+        if ((now - this->scanPoll) < AKC_SCAN_HOLD_POLL)
+            break;
+        if (isScannerSignal())
+            this->scanTime = now;
+        else if ((now - this->scanTime) >= this->scanHang)
+        {
+            setScannerMute(true);
+            this->scanState = AKC_SCAN_HOP;
+            if (this->scanCallback != NULL)
+                this->scanCallback(this->scanIndex, false);
+        }
+        break;
+    }
+    return this->scanState;
+}
+#endif
+
+
+#if AKC695X_USE_DUAL_WATCH
+/**
+ * @defgroup GA17 Priority Channel Dual-Watch
+ * @section  GA17 Priority Channel Dual-Watch
+ * @details The dual-watch listens to the main channel and checks a priority channel of the same band every interval ms.
+ * @details A check mutes the audio, tunes the priority channel with a single burst write of REG00 to REG03 prepared in advance,
+ * @details triggers the tune process, waits AKC_WATCH_SETTLE_TIME and reads the whole status block once in a single burst.
+ * @details The main channel is tuned again the same way and the audio is unmuted AKC_WATCH_SETTLE_TIME after the trigger.
+ * @details The check never waits for the device: each call of processDualWatch runs at most one transaction.
+ * @details The time the audio of the main channel is muted is measured in every check that ends on the main channel,
+ * @details including the return from the priority channel (see getDualWatchOffTime).
+ * @details When the priority channel is active (RSSI and CNR), the receiver switches over to it. When it gets quiet, the receiver
+ * @details goes back to the main channel.
+ * @code
+ * radio.setFrequency(1039);                    // Main channel
+ * radio.startDualWatch(1061, 2000, 25, 10);    // Checks 106.1MHz every 2s
+ * ...
+ * void loop() {
+ *   radio.processDualWatch();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA17
+ * @brief Starts the dual-watch
+ * @details The main channel is the current frequency. Do not change the frequency, band or mode while the dual-watch is running (see stopDualWatch).
+ *
+ * @param priority_frequency  priority channel (current band)
+ * @param interval            time (in ms) between two checks of the priority channel
+ * @param min_rssi            minimum RSSI (dBuV) of an active priority channel
+ * @param min_cnr             minimum CNR (dB) of an active priority channel
+ */
+void AKC695X::startDualWatch(uint16_t priority_frequency, uint16_t interval, int8_t min_rssi, uint8_t min_cnr)
+{
+    completeRegisterImage(); // REG01 is written in each hop
+
+    this->watchMain = this->currentFrequency;
+    this->watchPriority = priority_frequency;
+    this->watchInterval = interval;
+    this->watchMinRssi = min_rssi;
+    this->watchMinCnr = min_cnr;
+    this->watchMaxOffTime = 0;
+    prepareTuneImage(this->watchMain, this->watchMainImage);
+    prepareTuneImage(this->watchPriority, this->watchPriorityImage);
+
+    this->watchTime = millis();
+    this->watchReady = micros();
+    this->watchStep = AKC_WATCH_STEP_IDLE;
+    this->watchState = AKC_WATCH_MAIN;
+}
+
+/**
+ * @ingroup GA17
+ * @brief Stops the dual-watch
+ * @details A check in progress is completed first, so the audio is never left muted.
+ * @details The receiver stays on the channel it is (main or priority).
+ */
+void AKC695X::stopDualWatch()
+{
+    while (this->watchState != AKC_WATCH_STOPPED && this->watchStep != AKC_WATCH_STEP_IDLE)
+        processDualWatch();
+    this->watchState = AKC_WATCH_STOPPED;
+}
+
+/**
+ * @brief Writes registers without waiting for the guard time
+ * @details The guard time is controlled by watchReady.
+ *
+ * @param reg     first register
+ * @param values  register values (NULL if count = 0)
+ * @param count   number of registers (0 = just the register address)
+ * @return true   the device acknowledged the transaction
+ */
+bool AKC695X::watchWrite(uint8_t reg, const uint8_t *values, uint8_t count)
+{
+    bool ok = (busWrite(reg, values, count) == AKC_BUS_OK);
+
+    this->watchReady = micros() + AKC_WRITE_GUARD_TIME;
+    for (uint8_t i = 0; ok && i < count; i++)
+        registerWritten(reg + i, values[i]);
+    return ok;
+}
+
+/**
+ * @ingroup GA17
+ * @brief Runs the next step of the dual-watch
+ * @details Call this method as often as possible in your loop function. It returns immediately if the device is not ready
+ * @details or if no check is due.
+ *
+ * @return uint8_t  AKC_WATCH_STOPPED, AKC_WATCH_MAIN or AKC_WATCH_PRIORITY
+ */
+uint8_t AKC695X::processDualWatch()
+{
+    uint8_t values[8];
+    const uint8_t *image;
+
+    if (this->watchState == AKC_WATCH_STOPPED || (int32_t)(micros() - this->watchReady) < 0)
+        return this->watchState;
+
+    switch (this->watchStep)
+    {
+    case AKC_WATCH_STEP_IDLE:
+        if ((millis() - this->watchTime) < this->watchInterval)
+            return this->watchState;
+        this->watchTime = millis();
+        this->watchStart = micros();
+        // Already on the priority channel: just checks the activity
+        this->watchStep = (this->watchState == AKC_WATCH_PRIORITY) ? AKC_WATCH_STEP_ADDRESS : AKC_WATCH_STEP_HOP;
+        return this->watchState;
+    case AKC_WATCH_STEP_HOP: // Muted image (REG00 to REG03) in a single burst
+    case AKC_WATCH_STEP_BACK:
+        image = (this->watchStep == AKC_WATCH_STEP_HOP) ? this->watchPriorityImage : this->watchMainImage;
+        if (watchWrite(REG00, image, 4))
+            this->watchStep++;
+        return this->watchState;
+    case AKC_WATCH_STEP_TRIGGER:
+    case AKC_WATCH_STEP_RETUNE:
+        image = (this->watchStep == AKC_WATCH_STEP_TRIGGER) ? this->watchPriorityImage : this->watchMainImage;
+        values[0] = akc_reg0_tune::set(image[0], 1);
+        if (!watchWrite(REG00, values, 1))
+            return this->watchState;
+        this->watchReady = micros() + AKC_WATCH_SETTLE_TIME;
+        this->watchStep++;
+        return this->watchState;
+    case AKC_WATCH_STEP_ADDRESS:
+        if (watchWrite(REG20, NULL, 0))
+            this->watchStep = AKC_WATCH_STEP_READ;
+        return this->watchState;
+    case AKC_WATCH_STEP_UNMUTE: // tune bit = 0
+        values[0] = akc_reg0_mute::set(this->watchMainImage[0], 0);
+        if (!watchWrite(REG00, values, 1))
+            return this->watchState;
+        this->watchStep = AKC_WATCH_STEP_IDLE;
+        if (this->watchState == AKC_WATCH_MAIN)
+        {
+            this->watchOffTime = micros() - this->watchStart;
+            if (this->watchOffTime > this->watchMaxOffTime)
+                this->watchMaxOffTime = this->watchOffTime;
+        }
+        return this->watchState;
+    }
+
+    // Status block (REG20 to REG27) of the priority channel
+    this->watchReady = micros() + AKC_READ_GUARD_TIME;
+    if (busRead(values, 8) != AKC_BUS_OK)
+    {
+        this->watchStep = AKC_WATCH_STEP_ADDRESS; // Reads the status again
+        return this->watchState;
+    }
+    for (uint8_t i = 0; i < 8; i++)
+        registerRead(REG20 + i, values[i]);
+
+    if (akc_reg20_stc::get(values[0]) &&
+        calculateRSSI(values[REG24 - REG20], values[REG27 - REG20], this->watchPriority) >= this->watchMinRssi &&
+        ((this->currentMode == CURRENT_MODE_FM) ? akc_reg23_cnrfm::get(values[REG23 - REG20]) : akc_reg22_cnram::get(values[REG22 - REG20])) >= this->watchMinCnr)
+    {
+        // Active: switches over (or stays) and unmutes the priority channel
+        this->watchStep = (this->watchState == AKC_WATCH_PRIORITY) ? AKC_WATCH_STEP_IDLE : AKC_WATCH_STEP_UNMUTE;
+        this->watchState = AKC_WATCH_PRIORITY;
+        this->currentFrequency = this->watchPriority;
+    }
+    else
+    {
+        // Quiet: goes back to the main channel
+        this->watchStep = AKC_WATCH_STEP_BACK;
+        this->watchState = AKC_WATCH_MAIN;
+        this->currentFrequency = this->watchMain;
+    }
+    return this->watchState;
+}
+#endif
+
+
+#if AKC695X_USE_TELEMETRY
+/**
+ * @defgroup GA18 Telemetry Recorder
+ * @section  GA18 Telemetry Recorder
+ * @details The telemetry recorder samples the status block on a schedule (frequency, RSSI, CNR, stereo, tuned and supply
+ * @details voltage from a single burst read) for long-term reception monitoring. Each sample is stored as a delta against the
+ * @details previous one: a tag byte says which fields changed and only those follow, as zigzag varints (1 byte for a change
+ * @details up to +/-63). The time is not stored when the interval does not change. A typical sample costs 2 to 4 bytes
+ * @details against 25 to 30 bytes of a printed CSV line.
+ * @details The records are grouped in pages stored in a ring buffer declared in your sketch (the oldest pages are overwritten).
+ * @details Each page starts with a keyframe (absolute values). So, any page can be decoded alone. Each complete page can also
+ * @details be sent to a stream: Serial (captured to a file on the PC), a file of an SD card or a Print class of your sketch that
+ * @details writes the pages to an EEPROM.
+ * @details Use the host tool extras/tools/akc695x_telemetry.cpp to convert the pages to CSV.
+ *
+ * Page format:
+ *
+ * | Bytes | Content                                                              |
+ * | ----- | -------------------------------------------------------------------- |
+ * | 1     | AKC_TELEMETRY_SYNC (0xA7)                                            |
+ * | 2     | page sequence number (little-endian)                                 |
+ * | 1     | n = number of bytes of records                                       |
+ * | n     | records                                                              |
+ * | 1     | XOR of all bytes after the sync byte                                 |
+ *
+ * Record format (varint = 7 bits per byte, least significant first, bit 7 = more bytes; zigzag = signed value as 0, -1, 1, -2...):
+ *
+ * | Record    | Tag bits                                          | Fields (varints)                                      |
+ * | --------- | ------------------------------------------------- | ----------------------------------------------------- |
+ * | keyframe  | 7 = 1; 6 = tuned; 5 = stereo; 0 = FM              | time, frequency, RSSI (zigzag), CNR, vbat             |
+ * | delta     | 7 = 0; 6 = tuned; 5 = stereo; 0 to 4 = fields     | time delta, then the zigzag differences of frequency, |
+ * |           | present (time, frequency, RSSI, CNR, vbat)        | RSSI, CNR and vbat (only the fields present)          |
+ *
+ * @code
+ * uint8_t pages[256];         // 4 pages of 64 bytes
+ * ...
+ * radio.setTelemetry(pages, sizeof(pages), AKC_TELEMETRY_PAGE_SIZE, &Serial);
+ * radio.startTelemetry(10000);  // One sample every 10s
+ * ...
+ * void loop() {
+ *   radio.processTelemetry();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA18
+ * @brief Sets the pages of the telemetry recorder
+ * @details The buffer is split in pages of page_size bytes (up to 255 pages). The records of a page never cross its end.
+ * @details Use the page size of your EEPROM if the pages are written to it.
+ *
+ * @see startTelemetry, dumpTelemetry
+ *
+ * @param buffer     array declared in your sketch
+ * @param size       size of the buffer (in bytes)
+ * @param page_size  size of a page (in bytes). Default: AKC_TELEMETRY_PAGE_SIZE
+ * @param output     stream that receives each complete page (for example: &Serial) or NULL
+ * @return false     if the buffer can not hold a page
+ */
+bool AKC695X::setTelemetry(uint8_t *buffer, uint16_t size, uint8_t page_size, Print *output)
+{
+    if (buffer == NULL || page_size < (AKC_TELEMETRY_HEADER + AKC_TELEMETRY_MAX_RECORD + 1) || size < page_size)
+        return false;
+
+    this->telemetryBuffer = buffer;
+    this->telemetryPageSize = page_size;
+    this->telemetryPages = (size / page_size > 255) ? 255 : size / page_size;
+    this->telemetryOutput = output;
+    this->telemetryHead = 0;
+    this->telemetryStored = 0;
+    this->telemetryUsed = 0;
+    this->telemetrySeq = 0;
+    this->telemetryStart = millis();
+    return true;
+}
+
+/**
+ * @ingroup GA18
+ * @brief Starts the scheduled samples
+ * @details The times of the samples are counted from this call. The first sample is taken by the next processTelemetry call.
+ *
+ * @see processTelemetry, stopTelemetry
+ *
+ * @param interval  time (in ms) between two samples. Use a multiple of AKC_TELEMETRY_TIME_UNIT.
+ */
+void AKC695X::startTelemetry(uint32_t interval)
+{
+    if (this->telemetryPages == 0)
+        return;
+    flushTelemetry(); // The time base changes
+    this->telemetryInterval = interval;
+    this->telemetryStart = millis();
+    this->telemetryLast = this->telemetryStart - interval;
+}
+
+/**
+ * @ingroup GA18
+ * @brief Stops the scheduled samples and flushes the current page
+ */
+void AKC695X::stopTelemetry()
+{
+    this->telemetryInterval = 0;
+    flushTelemetry();
+}
+
+/**
+ * @ingroup GA18
+ * @brief Takes a sample when the interval is over
+ * @details Call it in the loop function. If the loop was busy for more than an interval, the missed samples are skipped.
+ *
+ * @return true  a sample was recorded
+ */
+bool AKC695X::processTelemetry()
+{
+    uint32_t now = millis();
+
+    if (this->telemetryInterval == 0 || (now - this->telemetryLast) < this->telemetryInterval)
+        return false;
+
+    this->telemetryLast += this->telemetryInterval; // Keeps the schedule. So, the time deltas repeat and are not stored
+    if ((now - this->telemetryLast) >= this->telemetryInterval)
+        this->telemetryLast = now;
+    return recordTelemetry();
+}
+
+/**
+ * @ingroup GA18
+ * @brief Reads the status block and records a sample now
+ *
+ * @see getTelemetrySample
+ *
+ * @return false  if the recorder has no pages or if the status block could not be read
+ */
+bool AKC695X::recordTelemetry()
+{
+    akc_telemetry_sample sample;
+    uint8_t regs[8], record[AKC_TELEMETRY_MAX_RECORD];
+    uint8_t length, reg20, reg23;
+    uint16_t channel;
+    bool keyframe;
+
+    if (this->telemetryPages == 0 || !getRegisters(REG20, regs, 8))
+        return false;
+
+    reg20 = regs[0];
+    reg23 = regs[REG23 - REG20];
+
+    // Same calculation of channelToFrequency
+    channel = (akc_reg20_readchan::get(reg20) << 8) | regs[REG21 - REG20];
+    if (this->currentMode == CURRENT_MODE_FM)
+        sample.frequency = (channel >> 2) + 300;
+    else
+        sample.frequency = channel * ((this->currentMode3k) ? 3 : 5);
+
+    sample.time = (millis() - this->telemetryStart) / AKC_TELEMETRY_TIME_UNIT;
+    sample.rssi = calculateRSSI(regs[REG24 - REG20], regs[REG27 - REG20], sample.frequency);
+    sample.cnr = (this->currentMode == CURRENT_MODE_FM) ? akc_reg23_cnrfm::get(reg23) : akc_reg22_cnram::get(regs[REG22 - REG20]);
+    sample.vbat = akc_reg25_vbat::get(regs[REG25 - REG20]);
+    sample.flags = ((this->currentMode == CURRENT_MODE_FM) ? AKC_TELEMETRY_FM : 0) |
+                   (akc_reg20_tuned::get(reg20) ? AKC_TELEMETRY_TUNED : 0) |
+                   (akc_reg23_st_dem::get(reg23) ? AKC_TELEMETRY_STEREO : 0);
+
+    // The mode is stored only in the keyframes
+    keyframe = this->telemetryUsed == 0 || ((sample.flags ^ this->telemetrySample.flags) & AKC_TELEMETRY_FM);
+    length = encodeTelemetry(&sample, record, keyframe);
+    if ((AKC_TELEMETRY_HEADER + this->telemetryUsed + length + 1) > this->telemetryPageSize)
+    {
+        nextTelemetryPage();
+        length = encodeTelemetry(&sample, record, true);
+    }
+
+    memcpy(this->telemetryBuffer + this->telemetryHead * this->telemetryPageSize + AKC_TELEMETRY_HEADER + this->telemetryUsed, record, length);
+    this->telemetryUsed += length;
+    this->telemetrySample = sample;
+    return true;
+}
+
+/**
+ * @ingroup GA18
+ * @brief Encodes a sample against the previous one (telemetrySample)
+ *
+ * @param sample    sample to be encoded
+ * @param record    array with AKC_TELEMETRY_MAX_RECORD elements that receives the record
+ * @param keyframe  true = absolute values
+ * @return uint8_t  size of the record (in bytes)
+ */
+uint8_t AKC695X::encodeTelemetry(const akc_telemetry_sample *sample, uint8_t *record, bool keyframe)
+{
+    const akc_telemetry_sample *previous = &this->telemetrySample;
+    uint32_t values[5], value;
+    uint8_t count = 0, length = 1;
+
+    record[0] = sample->flags & (AKC_TELEMETRY_TUNED | AKC_TELEMETRY_STEREO);
+
+    if (keyframe)
+    {
+        record[0] |= AKC_TELEMETRY_KEYFRAME | (sample->flags & AKC_TELEMETRY_FM);
+        values[count++] = sample->time;
+        values[count++] = sample->frequency;
+        values[count++] = ((uint32_t)(int32_t)sample->rssi << 1) ^ (uint32_t)((int32_t)sample->rssi >> 31);
+        values[count++] = sample->cnr;
+        values[count++] = sample->vbat;
+        this->telemetryDelta = 0;
+    }
+    else
+    {
+        int32_t delta[4] = {(int32_t)sample->frequency - previous->frequency, sample->rssi - previous->rssi,
+                            sample->cnr - previous->cnr, sample->vbat - previous->vbat};
+
+        value = sample->time - previous->time;
+        if (value != this->telemetryDelta)
+        {
+            record[0] |= 0x01;
+            values[count++] = value;
+            this->telemetryDelta = value;
+        }
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            if (delta[i] == 0)
+                continue;
+            record[0] |= 0x02 << i;
+            values[count++] = ((uint32_t)delta[i] << 1) ^ (uint32_t)(delta[i] >> 31);
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        for (value = values[i]; value >= 0x80; value >>= 7)
+            record[length++] = (value & 0x7F) | 0x80;
+        record[length++] = value;
+    }
+    return length;
+}
+
+/**
+ * @ingroup GA18
+ * @brief Writes the header and the checksum of the page being filled
+ * @details The page stays open. The next record overwrites the checksum.
+ *
+ * @return uint8_t  size of the page (header, records and checksum)
+ */
+uint8_t AKC695X::closeTelemetryPage()
+{
+    uint8_t *page = this->telemetryBuffer + this->telemetryHead * this->telemetryPageSize;
+    uint8_t checksum = 0, i;
+
+    page[0] = AKC_TELEMETRY_SYNC;
+    page[1] = this->telemetrySeq & 0xFF;
+    page[2] = this->telemetrySeq >> 8;
+    page[3] = this->telemetryUsed;
+    for (i = 1; i < AKC_TELEMETRY_HEADER + this->telemetryUsed; i++)
+        checksum ^= page[i];
+    page[i] = checksum;
+    return i + 1;
+}
+
+/**
+ * @ingroup GA18
+ * @brief Closes the page being filled, sends it to the output and moves to the next page of the ring
+ */
+void AKC695X::nextTelemetryPage()
+{
+    uint8_t length = closeTelemetryPage();
+
+    if (this->telemetryOutput != NULL)
+        this->telemetryOutput->write(this->telemetryBuffer + this->telemetryHead * this->telemetryPageSize, length);
+
+    this->telemetryHead = (this->telemetryHead + 1) % this->telemetryPages;
+    if (this->telemetryStored < (this->telemetryPages - 1))
+        this->telemetryStored++;
+    this->telemetrySeq++;
+    this->telemetryUsed = 0;
+}
+
+/**
+ * @ingroup GA18
+ * @brief Closes the page being filled even if it is not full
+ * @details The page is sent to the output (see setTelemetry) and the next sample starts a new page. Call it before
+ * @details powering down the system if the pages are written to an EEPROM.
+ */
+void AKC695X::flushTelemetry()
+{
+    if (this->telemetryUsed != 0)
+        nextTelemetryPage();
+}
+
+/**
+ * @ingroup GA18
+ * @brief Sends all pages of the ring (oldest first) to a stream
+ * @details The page being filled is sent too. It is not closed, so the next samples go to the same page.
+ *
+ * @param output  stream (for example: &Serial)
+ */
+void AKC695X::dumpTelemetry(Print *output)
+{
+    const uint8_t *page;
+    uint16_t idx;
+
+    for (uint8_t i = 0; i < this->telemetryStored; i++)
+    {
+        idx = (this->telemetryHead + this->telemetryPages - this->telemetryStored + i) % this->telemetryPages;
+        page = this->telemetryBuffer + idx * this->telemetryPageSize;
+        output->write(page, AKC_TELEMETRY_HEADER + page[3] + 1);
+    }
+    if (this->telemetryUsed != 0)
+        output->write(this->telemetryBuffer + this->telemetryHead * this->telemetryPageSize, closeTelemetryPage());
+}
+#endif
+
+
+#if AKC695X_USE_AFC
+/**
+ * @defgroup GA19 Automatic Frequency Control
+ * @section  GA19 Automatic Frequency Control
+ * @details REG26 shows the offset between the station and the tuned channel (FM: 1kHz units; AM: 100Hz units). The AFC reads it
+ * @details in the same burst of the status block, keeps a moving average and tunes the next channel (FM: 25kHz; AM: 5kHz or
+ * @details 3kHz) when the average goes over AKC_AFC_THRESHOLD % of the channel spacing. This fixes off-grid stations of custom
+ * @details bands and the drift of the 32kHz crystal. The retunes are at least hold ms apart and the correction is limited to
+ * @details AKC_AFC_MAX_CHANNELS. So, the AFC does not thrash the tuner or walk to a neighbor station.
+ * @details The correction is relative to the current frequency (getFrequency does not change). It starts over when the
+ * @details receiver is tuned by other method (setFrequency, seek etc).
+ * @details The offset is considered positive when the station is above the tuned channel.
+ * @code
+ * radio.startAfc();
+ * ...
+ * void loop() {
+ *   radio.processAfc();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA19
+ * @brief Starts the automatic frequency control
+ *
+ * @see processAfc, getAfcPpm
+ *
+ * @param interval  time (in ms) between two offset reads. Default: AKC_AFC_INTERVAL
+ * @param hold      minimum time (in ms) between two retunes. Default: AKC_AFC_HOLD_TIME
+ */
+void AKC695X::startAfc(uint16_t interval, uint16_t hold)
+{
+    this->afcInterval = (interval == 0) ? 1 : interval;
+    this->afcHold = hold;
+    this->afcBase = frequencyToChannel(this->currentFrequency);
+    this->afcChannels = 0;
+    this->afcCount = 0;
+    this->afcTime = millis() - this->afcInterval;
+    this->afcRetuneTime = millis() - hold;
+}
+
+/**
+ * @ingroup GA19
+ * @brief Stops the automatic frequency control
+ * @details The current correction is kept. Call setFrequency to tune the nominal channel again.
+ */
+void AKC695X::stopAfc()
+{
+    this->afcInterval = 0;
+}
+
+/**
+ * @ingroup GA19
+ * @brief Reads the frequency offset and retunes when it persists
+ * @details Call it in the loop function. The offset is read only if the receiver is tuned on a station.
+ *
+ * @return true  the receiver was retuned
+ */
+bool AKC695X::processAfc()
+{
+    uint8_t regs[8];
+    uint16_t nominal, channel;
+    int16_t threshold;
+    int8_t step;
+
+    if (this->afcInterval == 0 || (millis() - this->afcTime) < this->afcInterval)
+        return false;
+    this->afcTime = millis();
+
+    if (!getRegisters(REG20, regs, 8) || !akc_reg20_stc::get(regs[0]))
+        return false;
+
+    // Tuned by other method: the correction starts over from the channel in use
+    nominal = frequencyToChannel(this->currentFrequency);
+    channel = (akc_reg20_readchan::get(regs[0]) << 8) | regs[REG21 - REG20];
+    if (nominal != this->afcBase || channel != (uint16_t)(this->afcBase + this->afcChannels))
+    {
+        this->afcBase = nominal;
+        this->afcChannels = (int8_t)(channel - nominal);
+        this->afcCount = 0;
+    }
+
+    if (!akc_reg20_tuned::get(regs[0]))
+    {
+        this->afcCount = 0; // No station: the offset is meaningless
+        return false;
+    }
+
+    if (this->afcCount == 0)
+        this->afcAverage = (int8_t)regs[REG26 - REG20] * 16;
+    else
+        this->afcAverage += ((int8_t)regs[REG26 - REG20] * 16 - this->afcAverage) / AKC_AFC_SAMPLES;
+    if (this->afcCount < AKC_AFC_SAMPLES)
+    {
+        this->afcCount++;
+        return false;
+    }
+
+    if ((millis() - this->afcRetuneTime) < this->afcHold)
+        return false;
+
+    // Channel spacing in REG26 units: FM = 25 * 1kHz; AM = 50 or 30 * 100Hz
+    threshold = ((this->currentMode == CURRENT_MODE_FM) ? 25 : ((this->currentMode3k) ? 30 : 50)) * 16 * AKC_AFC_THRESHOLD / 100;
+    if (this->afcAverage > threshold)
+        step = 1;
+    else if (this->afcAverage < -threshold)
+        step = -1;
+    else
+        return false;
+    if (abs(this->afcChannels + step) > AKC_AFC_MAX_CHANNELS)
+        return false;
+
+    this->afcChannels += step;
+    tuneChannel(this->afcBase + this->afcChannels);
+    this->afcRetuneTime = millis();
+    this->afcCount = 0;
+    return true;
+}
+
+/**
+ * @ingroup GA19
+ * @brief Gets the average frequency offset of the tuned channel
+ *
+ * @return int32_t  offset in Hz (positive = the station is above the tuned channel). 0 if there is no average yet
+ */
+int32_t AKC695X::getAfcOffset()
+{
+    if (this->afcCount == 0)
+        return 0;
+    return (int32_t)this->afcAverage * ((this->currentMode == CURRENT_MODE_FM) ? 1000 : 100) / 16;
+}
+
+/**
+ * @ingroup GA19
+ * @brief Estimates the error of the reference crystal
+ * @details The station offset from the nominal channel (AFC correction plus the average offset) divided by the frequency.
+ * @details Measure it on a strong station of known frequency (on the channel grid) and keep the value of each unit to
+ * @details calibrate it. The resolution is the REG26 unit: about 10ppm on FM.
+ *
+ * @return int32_t  error in ppm (positive = the reference runs fast and the receiver tunes above the nominal frequency)
+ */
+int32_t AKC695X::getAfcPpm()
+{
+    int32_t error;
+    uint32_t khz;
+
+    if (this->currentMode == CURRENT_MODE_FM)
+    {
+        error = (int32_t)this->afcChannels * 25000;
+        khz = (uint32_t)this->currentFrequency * 100;
+    }
+    else
+    {
+        error = (int32_t)this->afcChannels * ((this->currentMode3k) ? 3000 : 5000);
+        khz = this->currentFrequency;
+    }
+    error += getAfcOffset();
+    return (khz == 0) ? 0 : -error * 1000 / (int32_t)khz;
+}
+#endif
+
+
+#if AKC695X_USE_ATS
+/**
+ * @defgroup GA20 Automatic Tuning Storage
+ * @section  GA20 Automatic Tuning Storage
+ * @details The ATS sweeps one or more bands of the band plan and fills a preset list (see akc_preset) with the best stations.
+ * @details The sweep is non-blocking: processAts runs one I2C transaction per call, when the guard time of the previous one is
+ * @details over (same measurement path of the bandscope: burst write of REG00 to REG03, tune trigger and burst read of the status
+ * @details block). So, it can run at boot while the user interface keeps working.
+ * @details A station is a local maximum of the RSSI along the band that beats the minimum RSSI and whose CNR validates it
+ * @details (the adjacent channels of a strong station have a high RSSI but a poor CNR). Peaks up to AKC_ATS_GUARD steps apart
+ * @details are the same station: only the best one is kept. The stations are ranked by quality (RSSI + CNR) and the list keeps
+ * @details the best ones, the best first. The audio is muted during the sweep. At the end, the band and the frequency in use
+ * @details before startAts are restored.
+ * @code
+ * const uint8_t bands[] = {0, 2};   // Band plan indexes (see getBandPlan)
+ * akc_preset presets[12];
+ * ...
+ * radio.startAts(bands, 2, presets, 12, 20, 10);
+ * ...
+ * void loop() {
+ *   if (radio.processAts()) {
+ *     // radio.getAtsCount() presets were found
+ *   }
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA20
+ * @brief Starts the automatic tuning storage
+ * @details Do not change the frequency, band or mode while the ATS is running (see stopAts).
+ *
+ * @see processAts, getAtsCount, getAtsScore
+ *
+ * @param bands       band plan indexes declared in your sketch (see getBandPlan)
+ * @param band_count  number of bands
+ * @param presets     presets declared in your sketch. They receive the stations found, the best first
+ * @param size        number of presets (up to AKC_ATS_MAX_PRESETS)
+ * @param min_rssi    minimum RSSI (dBuV) of a station
+ * @param min_cnr     minimum CNR (dB) of a station
+ * @return false      if the parameters are invalid
+ */
+bool AKC695X::startAts(const uint8_t *bands, uint8_t band_count, akc_preset *presets, uint8_t size, int8_t min_rssi, uint8_t min_cnr)
+{
+    if (bands == NULL || band_count == 0 || presets == NULL || size == 0)
+        return false;
+
+    this->atsRestore.mode_band = (this->currentMode << 7) | this->currentBand;
+    this->atsRestore.frequency = this->currentFrequency;
+    this->atsRestoreMinimum = this->currentBandMinimumFrequency;
+    this->atsRestoreMaximum = this->currentBandMaximumFrequency;
+    this->atsRestoreStep = this->currentStep;
+    this->atsRestore3k = this->currentMode3k;
+
+    this->atsBands = bands;
+    this->atsBandCount = band_count;
+    this->atsBandIdx = 0;
+    this->atsPresets = presets;
+    this->atsSize = (size > AKC_ATS_MAX_PRESETS) ? AKC_ATS_MAX_PRESETS : size;
+    this->atsCount = 0;
+    this->atsMinRssi = min_rssi;
+    this->atsMinCnr = min_cnr;
+    this->atsReady = micros();
+    this->atsState = AKC_ATS_BAND;
+    return true;
+}
+
+/**
+ * @ingroup GA20
+ * @brief Stops the ATS and restores the band and the frequency in use before startAts
+ * @details The stations found so far are kept in the presets.
+ */
+void AKC695X::stopAts()
+{
+    if (this->atsState == AKC_ATS_STOPPED)
+        return;
+    this->atsState = AKC_ATS_STOPPED;
+    while ((int32_t)(micros() - this->atsReady) < 0)
+        ;
+
+    if (this->atsRestore.mode_band & AKC_PLAN_FM)
+        setFM(this->atsRestore.mode_band & 0x7F, this->atsRestoreMinimum, this->atsRestoreMaximum, this->atsRestore.frequency, this->atsRestoreStep);
+    else
+    {
+        setMode3k(this->atsRestore3k);
+        setAM(this->atsRestore.mode_band, this->atsRestoreMinimum, this->atsRestoreMaximum, this->atsRestore.frequency, this->atsRestoreStep);
+    }
+}
+
+/**
+ * @ingroup GA20
+ * @brief Writes registers without waiting for the guard time
+ * @details The guard time is controlled by atsReady.
+ *
+ * @param reg     first register
+ * @param values  register values (NULL if count = 0)
+ * @param count   number of registers (0 = just the register address)
+ * @return true   the device acknowledged the transaction
+ */
+bool AKC695X::atsWrite(uint8_t reg, const uint8_t *values, uint8_t count)
+{
+    bool ok = (busWrite(reg, values, count) == AKC_BUS_OK);
+
+    this->atsReady = micros() + AKC_WRITE_GUARD_TIME;
+    for (uint8_t i = 0; ok && i < count; i++)
+        registerWritten(reg + i, values[i]);
+    return ok;
+}
+
+/**
+ * @ingroup GA20
+ * @brief Sets up the next band of the list
+ * @details Invalid band plan indexes are skipped.
+ */
+void AKC695X::atsNextBand()
+{
+    uint8_t idx;
+
+    do
+    {
+        idx = this->atsBands[this->atsBandIdx++];
+    } while (idx >= getBandPlanSize() && this->atsBandIdx < this->atsBandCount);
+
+    if (idx >= getBandPlanSize())
+        return;
+
+    useBandPlan(idx, 0);
+    completeRegisterImage(); // REG01 is written in each tune
+
+    this->atsFrequency = this->currentBandMinimumFrequency;
+    this->atsRssi[0] = this->atsRssi[1] = INT8_MIN;
+    this->atsPeak = 0;
+    this->atsReady = micros() + AKC_WRITE_GUARD_TIME;
+    this->atsState = AKC_ATS_TUNE;
+}
+
+/**
+ * @ingroup GA20
+ * @brief Runs the next step of the ATS
+ * @details Call this method as often as possible in your loop function. It returns immediately if the device is not ready.
+ *
+ * @return true  the ATS is over (the presets are filled and the previous band and frequency are restored)
+ */
+bool AKC695X::processAts()
+{
+    uint8_t values[8], cnr;
+    int16_t rssi;
+
+    if (this->atsState == AKC_ATS_STOPPED || (int32_t)(micros() - this->atsReady) < 0)
+        return false;
+
+    switch (this->atsState)
+    {
+    case AKC_ATS_BAND:
+        if (this->atsBandIdx >= this->atsBandCount)
+        {
+            stopAts();
+            return true;
+        }
+        atsNextBand();
+        return false;
+    case AKC_ATS_TUNE: // REG00 (tune = 0), REG01 and the channel (REG02 and REG03) in a single burst
+        prepareTuneImage(this->atsFrequency, values);
+        if (atsWrite(REG00, values, 4))
+            this->atsState = AKC_ATS_TRIGGER;
+        return false;
+    case AKC_ATS_TRIGGER:
+        values[0] = akc_fields<akc_reg0_fm_en, akc_reg0_mute, akc_reg0_power_on, akc_reg0_tune>::encode(this->currentMode, 1, 1, 1);
+        if (!atsWrite(REG00, values, 1))
+            return false;
+        this->atsTrigger = micros();
+        this->atsReady = this->atsTrigger + AKC_ATS_SETTLE_TIME;
+        this->atsState = AKC_ATS_ADDRESS;
+        return false;
+    case AKC_ATS_ADDRESS:
+        if (atsWrite(REG20, NULL, 0))
+            this->atsState = AKC_ATS_READ;
+        return false;
+    }
+
+    // Status block (REG20 to REG27)
+    this->atsState = AKC_ATS_ADDRESS;
+    this->atsReady = micros() + AKC_READ_GUARD_TIME;
+    if (busRead(values, 8) != AKC_BUS_OK)
+        return false; // Reads the status again
+    for (uint8_t i = 0; i < 8; i++)
+        registerRead(REG20 + i, values[i]);
+
+    if (!akc_reg20_stc::get(values[0]) && (micros() - this->atsTrigger) < (MAX_TUNE_TIME * 1000UL))
+        return false; // Not tuned yet. Reads the status again.
+
+    rssi = calculateRSSI(values[REG24 - REG20], values[REG27 - REG20], this->atsFrequency);
+    cnr = (this->currentMode == CURRENT_MODE_FM) ? akc_reg23_cnrfm::get(values[REG23 - REG20]) : akc_reg22_cnram::get(values[REG22 - REG20]);
+    atsMeasure((rssi < -127) ? -127 : ((rssi > 127) ? 127 : rssi), cnr);
+#if AKC695X_USE_SIGNAL_CACHE
+    // The band being swept is the current one (see atsNextBand)
+    if (this->signalCache != NULL)
+        storeSignalCache(getSignalCacheKey(), frequencyToChannel(this->atsFrequency), rssi, cnr, (this->currentMode == CURRENT_MODE_FM) ? akc_reg23_st_dem::get(values[REG23 - REG20]) : 0);
+#endif
+
+    this->atsFrequency += this->currentStep;
+    this->atsState = AKC_ATS_TUNE;
+    if (this->atsFrequency > this->currentBandMaximumFrequency)
+    {
+        atsMeasure(INT8_MIN, 0); // The last channel of the band can be a peak too
+        this->atsState = AKC_ATS_BAND;
+    }
+    return false;
+}
+
+/**
+ * @ingroup GA20
+ * @brief Checks if the previous channel is a station
+ * @details The previous channel is a station if its RSSI is not lower than the RSSI of its neighbors and if it beats the
+ * @details minimum RSSI and CNR.
+ *
+ * @param rssi  RSSI of the channel atsFrequency (INT8_MIN = out of the band)
+ * @param cnr   CNR of the channel atsFrequency
+ */
+void AKC695X::atsMeasure(int8_t rssi, uint8_t cnr)
+{
+    uint16_t frequency = this->atsFrequency - this->currentStep;
+    int8_t level = this->atsRssi[1];
+    int16_t score = level + this->atsCnr;
+
+    if (level != INT8_MIN && level >= this->atsRssi[0] && level >= rssi && level >= this->atsMinRssi && this->atsCnr >= this->atsMinCnr)
+    {
+        if (score < 0)
+            score = 0;
+        else if (score > 255)
+            score = 255;
+
+        if (this->atsPeak == 0 || (frequency - this->atsPeak) > (AKC_ATS_GUARD * this->currentStep))
+        {
+            atsInsert(frequency, score);
+            this->atsBest = frequency;
+            this->atsPeakScore = score;
+        }
+        else if (score > this->atsPeakScore)
+        {
+            // Same station of the previous peak: keeps the best one
+            atsRemove(this->atsBest);
+            atsInsert(frequency, score);
+            this->atsBest = frequency;
+            this->atsPeakScore = score;
+        }
+        this->atsPeak = frequency;
+    }
+
+    this->atsRssi[0] = this->atsRssi[1];
+    this->atsRssi[1] = rssi;
+    this->atsCnr = cnr;
+}
+
+/**
+ * @ingroup GA20
+ * @brief Adds a station of the current band to the presets
+ * @details The presets are kept in quality order. If the list is full, the weakest station is dropped.
+ *
+ * @param frequency  frequency of the station
+ * @param score      quality (RSSI + CNR)
+ */
+void AKC695X::atsInsert(uint16_t frequency, uint8_t score)
+{
+    uint8_t i;
+
+    if (this->atsCount == this->atsSize && score <= this->atsScore[this->atsCount - 1])
+        return;
+    if (this->atsCount < this->atsSize)
+        this->atsCount++;
+
+    for (i = this->atsCount - 1; i > 0 && this->atsScore[i - 1] < score; i--)
+    {
+        this->atsPresets[i] = this->atsPresets[i - 1];
+        this->atsScore[i] = this->atsScore[i - 1];
+    }
+    this->atsPresets[i].mode_band = (this->currentMode << 7) | this->currentBand;
+    this->atsPresets[i].frequency = frequency;
+    this->atsScore[i] = score;
+}
+
+/**
+ * @ingroup GA20
+ * @brief Removes a station of the current band from the presets
+ *
+ * @param frequency  frequency of the station
+ */
+void AKC695X::atsRemove(uint16_t frequency)
+{
+    uint8_t mode_band = (this->currentMode << 7) | this->currentBand;
+
+    for (uint8_t i = 0; i < this->atsCount; i++)
+    {
+        if (this->atsPresets[i].mode_band != mode_band || this->atsPresets[i].frequency != frequency)
+            continue;
+        for (this->atsCount--; i < this->atsCount; i++)
+        {
+            this->atsPresets[i] = this->atsPresets[i + 1];
+            this->atsScore[i] = this->atsScore[i + 1];
+        }
+        return;
+    }
+}
+#endif
+
+
+#if AKC695X_USE_RAMP
+/**
+ * @defgroup GA21 Volume Ramps
+ * @section  GA21 Volume Ramps
+ * @details A volume ramp changes the volume of REG06 step by step over a given time, following an easing curve. The ramp is
+ * @details non-blocking: processRamp writes REG06 only when the volume of the curve changes and when the guard time of the
+ * @details previous write is over. REG06 is built from the cached register image (it is read at most once, at the beginning of
+ * @details the ramp, if it is not known).
+ * @details softMute ramps the volume down to AKC_RAMP_MUTE_VOLUME and softUnmute ramps it back to the volume of the sketch.
+ * @details Use the softMute callback to switch bands without a click: the band is changed when the audio is already muted.
+ * @details setVolume (and setVolumeUp and setVolumeDown) stops the ramp and sets the volume at once.
+ * @code
+ * void switchBand() {
+ *   radio.useBandPlan(bandIdx, 0);   // Runs when the volume is down
+ *   radio.softUnmute();
+ * }
+ * ...
+ * radio.softMute(switchBand);
+ * ...
+ * void loop() {
+ *   radio.processRamp();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA21
+ * @brief Sets the time and the curve of the soft mute and unmute ramps
+ *
+ * @param time   ramp time in ms (0 = the volume changes at once). Default: AKC_RAMP_TIME
+ * @param curve  AKC_RAMP_LINEAR, AKC_RAMP_EASE_IN, AKC_RAMP_EASE_OUT or AKC_RAMP_SMOOTH (default)
+ */
+void AKC695X::setRampTime(uint16_t time, uint8_t curve)
+{
+    this->rampDefaultTime = time;
+    this->rampDefaultCurve = curve;
+}
+
+/**
+ * @ingroup GA21
+ * @brief Starts a ramp from the volume of the audio output
+ * @details If a ramp is running, the new one starts from the volume already reached.
+ *
+ * @param volume  volume at the end of the ramp
+ * @param time    ramp time in ms
+ * @param curve   AKC_RAMP_LINEAR to AKC_RAMP_SMOOTH
+ */
+void AKC695X::startRamp(uint8_t volume, uint16_t time, uint8_t curve)
+{
+    if (!this->rampRunning)
+    {
+        this->rampLevel = (this->softMuted) ? AKC_RAMP_MUTE_VOLUME : this->volume;
+        this->rampReg6 = (this->regImageValid & (1 << REG06)) ? this->regImage[REG06] : getRegister(REG06);
+        this->rampReady = micros();
+    }
+    this->rampFrom = this->rampLevel;
+    this->rampTo = volume;
+    this->rampTime = time;
+    this->rampCurve = curve;
+    this->rampStart = millis();
+    this->rampRunning = true;
+}
+
+/**
+ * @ingroup GA21
+ * @brief Changes the volume with a ramp
+ * @details The volume returned by getVolume changes at once. The audio output follows the ramp (see processRamp).
+ *
+ * @param volume  new volume (up to 63)
+ * @param time    ramp time in ms
+ * @param curve   AKC_RAMP_LINEAR, AKC_RAMP_EASE_IN, AKC_RAMP_EASE_OUT or AKC_RAMP_SMOOTH (default)
+ */
+void AKC695X::rampVolume(uint8_t volume, uint16_t time, uint8_t curve)
+{
+    if (volume > 63)
+        volume = 63;
+    startRamp(volume, time, curve);
+    this->volume = volume;
+    this->softMuted = false;
+    this->rampCallback = NULL;
+}
+
+/**
+ * @ingroup GA21
+ * @brief Ramps the volume down to AKC_RAMP_MUTE_VOLUME
+ * @details The volume of the sketch (getVolume) is kept for softUnmute.
+ *
+ * @see setRampTime
+ *
+ * @param callback  function called when the audio is muted (the end of the ramp) or NULL
+ */
+void AKC695X::softMute(void (*callback)())
+{
+    startRamp(AKC_RAMP_MUTE_VOLUME, this->rampDefaultTime, this->rampDefaultCurve);
+    this->softMuted = true;
+    this->rampCallback = callback;
+}
+
+/**
+ * @ingroup GA21
+ * @brief Ramps the volume back to the volume of the sketch
+ *
+ * @see setRampTime
+ */
+void AKC695X::softUnmute()
+{
+    startRamp(this->volume, this->rampDefaultTime, this->rampDefaultCurve);
+    this->softMuted = false;
+    this->rampCallback = NULL;
+}
+
+/**
+ * @ingroup GA21
+ * @brief Writes the volume of the curve to REG06
+ * @details Call this method as often as possible in your loop function. It returns immediately if no ramp is running or if
+ * @details the device is not ready.
+ *
+ * @return true  the ramp is over (the softMute callback was called)
+ */
+bool AKC695X::processRamp()
+{
+    uint32_t elapsed;
+    uint16_t x, y;
+    uint8_t level, reg6;
+    void (*callback)();
+
+    if (!this->rampRunning || (int32_t)(micros() - this->rampReady) < 0)
+        return false;
+
+    // Position (x) and eased position (y) in the ramp: 0 to 256
+    elapsed = millis() - this->rampStart;
+    x = (elapsed >= this->rampTime) ? 256 : (uint16_t)(elapsed * 256 / this->rampTime);
+    switch (this->rampCurve)
+    {
+    case AKC_RAMP_EASE_IN:
+        y = ((uint32_t)x * x) >> 8;
+        break;
+    case AKC_RAMP_EASE_OUT:
+        y = 256 - (((uint32_t)(256 - x) * (256 - x)) >> 8);
+        break;
+    case AKC_RAMP_SMOOTH:
+        y = ((uint32_t)x * x * (768 - 2 * x)) >> 16;
+        break;
+    default:
+        y = x;
+    }
+    level = this->rampFrom + (((int16_t)this->rampTo - this->rampFrom) * (int16_t)y) / 256;
+
+    if (level != this->rampLevel)
+    {
+        reg6 = akc_reg6_volume::set(this->rampReg6, level);
+        this->rampReady = micros() + AKC_WRITE_GUARD_TIME;
+        if (busWrite(REG06, &reg6, 1) != AKC_BUS_OK)
+            return false; // Writes it again in the next call
+        registerWritten(REG06, reg6);
+        this->rampLevel = level;
+    }
+    if (x < 256)
+        return false;
+
+    this->rampRunning = false;
+    callback = this->rampCallback;
+    this->rampCallback = NULL;
+    if (callback != NULL)
+        callback();
+    return true;
+}
+#endif
+
+
+#if AKC695X_USE_BUTTON
+/**
+ * @defgroup GA22 Push Button Gestures
+ * @section  GA22 Push Button Gestures
+ * @details AKC695XButton replaces the delay calls used to wait for the release of a button and the click counters of the loop
+ * @details function. The button is debounced with timestamps: a new level is accepted when it is stable for the debounce time.
+ * @details process recognizes a click, a double click (a second click before the double click time is over) and a long press
+ * @details (reported while the button is still held, so the sketch can react at once). It never waits. So, the encoder and the
+ * @details receiver keep being processed and the user interface latency is the loop period.
+ * @details A click is reported when the double click time is over. Set the double click time to 0 (see setTimes) to get the
+ * @details clicks at the release of the button when the double click is not used.
+ * @details The gestures can call functions of your sketch (see attach) that use the receiver API directly.
+ * @code
+ * AKC695XButton button;
+ *
+ * void onClick() { radio.frequencyUp(); }
+ * void onLongPress() { radio.seekStation(AKC_SEEK_UP, showFrequency); }
+ *
+ * void setup() {
+ *   ...
+ *   button.setup(ENCODER_PUSH_BUTTON);
+ *   button.attach(AKC_BUTTON_CLICK, onClick);
+ *   button.attach(AKC_BUTTON_LONG_PRESS, onLongPress);
+ * }
+ *
+ * void loop() {
+ *   button.process();
+ *   ...
+ * }
+ * @endcode
+ */
+
+/**
+ * @ingroup GA22
+ * @brief Sets the pin of the button
+ *
+ * @param pin         Arduino pin
+ * @param active_low  true (default) = the button connects the pin to GND (the internal pull-up is enabled)
+ */
+void AKC695XButton::setup(uint8_t pin, bool active_low)
+{
+    this->pin = pin;
+    this->activeLow = active_low;
+    pinMode(pin, (active_low) ? INPUT_PULLUP : INPUT);
+    this->level = this->pressed = false;
+    this->clicks = 0;
+    this->levelTime = millis();
+}
+
+/**
+ * @ingroup GA22
+ * @brief Changes the gesture times
+ *
+ * @param debounce      time (in ms) the button level must be stable. Default: AKC_BUTTON_DEBOUNCE_TIME
+ * @param double_click  maximum time (in ms) between two clicks of a double click (0 = no double click). Default: AKC_BUTTON_DOUBLE_TIME
+ * @param long_press    time (in ms) of a long press. Default: AKC_BUTTON_LONG_TIME
+ */
+void AKC695XButton::setTimes(uint16_t debounce, uint16_t double_click, uint16_t long_press)
+{
+    this->debounceTime = debounce;
+    this->doubleTime = double_click;
+    this->longTime = long_press;
+}
+
+/**
+ * @ingroup GA22
+ * @brief Sets the function called by process when a gesture is recognized
+ *
+ * @param gesture   AKC_BUTTON_CLICK, AKC_BUTTON_DOUBLE_CLICK or AKC_BUTTON_LONG_PRESS
+ * @param callback  function of your sketch (NULL = none)
+ */
+void AKC695XButton::attach(uint8_t gesture, void (*callback)())
+{
+    if (gesture >= AKC_BUTTON_CLICK && gesture <= AKC_BUTTON_LONG_PRESS)
+        this->callbacks[gesture - 1] = callback;
+}
+
+/**
+ * @ingroup GA22
+ * @brief Reads the button and recognizes the gestures
+ * @details Call it in the loop function. It does not wait.
+ *
+ * @return uint8_t  AKC_BUTTON_NONE, AKC_BUTTON_CLICK, AKC_BUTTON_DOUBLE_CLICK or AKC_BUTTON_LONG_PRESS
+ */
+uint8_t AKC695XButton::process()
+{
+    uint32_t now = millis();
+    uint8_t gesture = AKC_BUTTON_NONE;
+    bool current;
+
+    if (this->pin < 0)
+        return AKC_BUTTON_NONE;
+
+    current = (digitalRead(this->pin) == ((this->activeLow) ? LOW : HIGH));
+    if (current != this->level)
+    {
+        this->level = current;
+        this->levelTime = now;
+    }
+
+    if (this->level != this->pressed && (now - this->levelTime) >= this->debounceTime)
+    {
+        this->pressed = this->level;
+        if (this->pressed)
+        {
+            this->pressTime = now;
+            this->longSent = false;
+        }
+        else if (!this->longSent)
+        {
+            this->releaseTime = now;
+            if (++this->clicks >= 2)
+            {
+                this->clicks = 0;
+                gesture = AKC_BUTTON_DOUBLE_CLICK;
+            }
+        }
+    }
+
+    if (this->pressed && !this->longSent && (now - this->pressTime) >= this->longTime)
+    {
+        this->longSent = true;
+        this->clicks = 0; // A click before the long press is discarded
+        gesture = AKC_BUTTON_LONG_PRESS;
+    }
+    else if (this->clicks == 1 && !this->pressed && (now - this->releaseTime) >= this->doubleTime)
+    {
+        this->clicks = 0;
+        gesture = AKC_BUTTON_CLICK;
+    }
+
+    if (gesture != AKC_BUTTON_NONE && this->callbacks[gesture - 1] != NULL)
+        this->callbacks[gesture - 1]();
+    return gesture;
+}
+#endif
+
+
+#if AKC695X_USE_TRACE
+/**
+ * @defgroup GA07 I2C Trace
+ * @section  GA07 I2C Trace
+ * @details The I2C trace records every register operation (see akc_trace_record) and a marker at the beginning of the main API calls.
+ * @details The records can be stored in a RAM ring buffer or sent to a stream (Serial). Both can be used at the same time.
+ * @details Use the host tool extras/tools/akc695x_trace.cpp to summarize a captured trace (bus time and transactions per API call) or to compare two traces.
+ * @details When the trace is disabled (default), the cost is just a test in setRegister and getRegister.
+ */
+
+/**
+ * @ingroup GA07
+ * @brief Stores a trace record
+ * @details Computes the time elapsed since the previous record and writes the record in the ring buffer and/or the stream.
+ *
+ * @param op     AKC_TRACE_WRITE, AKC_TRACE_READ or AKC_TRACE_MARK
+ * @param reg    register number or API id (0 to 63)
+ * @param value  register value
+ */
+void AKC695X::trace(uint8_t op, uint8_t reg, uint8_t value)
+{
+    akc_trace_record record;
+    uint32_t now, delta;
+
+    if (this->traceBuffer == NULL && this->traceOutput == NULL)
+        return;
+
+    now = micros();
+    delta = (now - this->traceLastTime) / AKC_TRACE_TIME_UNIT;
+    this->traceLastTime = now;
+
+    record.op_reg = (op << 6) | (reg & 0x3F);
+    record.value = value;
+    record.delta = (delta > 0xFFFF) ? 0xFFFF : delta;
+
+    if (this->traceBuffer != NULL)
+    {
+        this->traceBuffer[this->traceHead] = record;
+        this->traceHead = (this->traceHead + 1) % this->traceSize;
+        if (this->traceCount < this->traceSize)
+            this->traceCount++;
+    }
+
+    if (this->traceOutput != NULL)
+    {
+        this->traceOutput->write(record.op_reg);
+        this->traceOutput->write(record.value);
+        this->traceOutput->write(record.delta & 0xFF);
+        this->traceOutput->write(record.delta >> 8);
+    }
+}
+
+/**
+ * @ingroup GA07
+ * @brief Enables the I2C trace in a RAM ring buffer
+ * @details When the buffer is full, the oldest records are replaced. Each record uses 4 bytes.
+ * @details Call this method with buffer = NULL to stop storing records.
+ *
+ * @code
+ * akc_trace_record traceRecords[64];
+ * ...
+ * radio.setTraceBuffer(traceRecords, 64);
+ * ...
+ * radio.dumpTrace(&Serial);  // Sends the binary records to the host
+ * @endcode
+ *
+ * @see dumpTrace, akc_trace_record
+ *
+ * @param buffer  array declared in your sketch (or NULL)
+ * @param size    number of elements of the array
+ */
+void AKC695X::setTraceBuffer(akc_trace_record *buffer, uint16_t size)
+{
+    this->traceBuffer = (size > 0) ? buffer : NULL;
+    this->traceSize = size;
+    this->traceHead = this->traceCount = 0;
+    this->traceLastTime = micros();
+}
+
+/**
+ * @ingroup GA07
+ * @brief Streams the I2C trace records
+ * @details Each record is written as 4 binary bytes (see akc_trace_record) as soon as it happens.
+ * @details Writing to the stream adds time to each register operation. Use a high baud rate.
+ *
+ * @param output  stream (for example: &Serial) or NULL to stop streaming
+ */
+void AKC695X::setTraceOutput(Print *output)
+{
+    this->traceOutput = output;
+    this->traceLastTime = micros();
+}
+
+/**
+ * @ingroup GA07
+ * @brief Stores an API call marker
+ * @details The host tool assigns the following register operations to this marker.
+ * @details The library uses the ids 1 to 31 (see AKC_API_SETUP and others). You can use the ids 32 to 63 to mark parts of your sketch.
+ *
+ * @param api_id  API id (1 to 63)
+ */
+void AKC695X::traceMark(uint8_t api_id)
+{
+    trace(AKC_TRACE_MARK, api_id, 0);
+}
+
+/**
+ * @ingroup GA07
+ * @brief Writes the records of the ring buffer to a stream
+ * @details The records are written from the oldest to the newest (4 bytes each). The ring buffer is cleared.
+ *
+ * @param output  stream (for example: &Serial)
+ */
+void AKC695X::dumpTrace(Print *output)
+{
+    uint16_t idx;
+    akc_trace_record *record;
+
+    if (this->traceBuffer == NULL)
+        return;
+
+    idx = (this->traceHead + this->traceSize - this->traceCount) % this->traceSize;
+    while (this->traceCount > 0)
+    {
+        record = &this->traceBuffer[idx];
+        output->write(record->op_reg);
+        output->write(record->value);
+        output->write(record->delta & 0xFF);
+        output->write(record->delta >> 8);
+        idx = (idx + 1) % this->traceSize;
+        this->traceCount--;
+    }
+    this->traceHead = 0;
+}
+#endif
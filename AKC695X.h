@@ -22,6 +22,7 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "AKC695X_config.h"
 
 #define DEFAUL_I2C_ADDRESS 0x10
 #define CURRENT_MODE_FM     1
@@ -30,11 +31,138 @@
 #define CRYSTAL_32KHz       1
 
 #define MAX_SEEK_TIME   3000        // Maximum time have to be a seeking process (in ms).
+#define MAX_TUNE_TIME   200         // Maximum time waiting for the STC bit after a tune (in ms).
+#define AKC_RESET_PULSE_TIME 1      // RESET pin low time used by fastSetup (in ms).
+#define AKC_RESET_WAIT_TIME  2      // Time waiting for the device after the RESET pin goes high in fastSetup (in ms).
 #define AKC_SEEK_UP 1
 #define AKC_SEEK_DOWN 0
 #define AKC_FM 1
 #define AKC_AM 0
 
+#define AKC_CACHE_MISS  0           // No information about the channel in the signal cache
+#define AKC_CACHE_STALE 1           // The cached information is older than the max age (see setSignalCache)
+#define AKC_CACHE_FRESH 2           // The cached information can be used
+#define AKC_CACHE_MAX_SIZE 127      // Maximum number of elements of the signal cache (the indexes are int8_t)
+
+#define AKC_TRACE_WRITE 0           // Trace record: register written (see setTraceBuffer)
+#define AKC_TRACE_READ  1           // Trace record: register read
+#define AKC_TRACE_MARK  2           // Trace record: API call marker. The register field is the API id.
+#define AKC_TRACE_TIME_UNIT 16      // Time unit (in us) of the trace record delta time
+
+#define AKC_TUND_POLL_TIME  50      // Interval (in ms) of the REG20 reads when the TUND pin does not change (see setTundPin)
+
+#define AKC_BANDSCOPE_SETTLE_TIME 5000   // Time (in us) between the bandscope tune trigger and the first status read
+#define AKC_BANDSCOPE_THRESHOLD   2      // Minimum level change (in dBuV) that makes a bandscope bin be sent again
+#define AKC_BANDSCOPE_SYNC        0xB5   // First byte of a bandscope frame (see sendBandscopeFrame)
+
+#define AKC_STATUS_SUBSCRIBERS 4     // Maximum number of status change callbacks (see subscribeStatus)
+#define AKC_STATUS_THRESHOLD   2     // Default RSSI and CNR change (in dB) notified to the subscribers
+
+#define AKC_SCAN_STOPPED 0           // Scanner state: not running (see startScanner)
+#define AKC_SCAN_HOP     1           // Scanner state: the next preset will be tuned
+#define AKC_SCAN_LISTEN  2           // Scanner state: measuring the signal of the current preset (dwell time)
+#define AKC_SCAN_HOLD    3           // Scanner state: stopped on an active preset
+#define AKC_SCAN_SETTLE_TIME 10      // Time (in ms) between the tune trigger and the first signal measure
+#define AKC_SCAN_HOLD_POLL   100     // Interval (in ms) of the signal measures while the scanner is stopped on a preset
+
+#define AKC_BUS_OK           0       // I2C result: success (same codes of Wire.endTransmission)
+#define AKC_BUS_NACK_ADDRESS 2       // I2C result: the device did not acknowledge its address
+#define AKC_BUS_NACK_DATA    3       // I2C result: the device did not acknowledge a data byte
+#define AKC_BUS_OTHER        4       // I2C result: other error (lost arbitration, bus error)
+#define AKC_BUS_TIMEOUT      5       // I2C result: the transfer did not finish in AKC_BUS_TIMEOUT_TIME
+#define AKC_BUS_SHORT_READ   6       // I2C result: the device sent less bytes than requested
+#define AKC_BUS_TIMEOUT_TIME 5000    // Maximum time (in us) of an I2C transfer (Wire.setWireTimeout, when the core has it)
+#define AKC_BUS_RETRIES      2       // Default number of times a failed transaction is repeated (see setBusRetries)
+#define AKC_BUS_MAX_RETRIES  8       // Maximum number of retries
+#define AKC_BUS_RECOVERY_CLOCKS 9    // SCL pulses sent to release a stuck SDA line (see recoverBus)
+#define AKC_BUS_RECOVERY_TIME   500  // Maximum time (in us) of recoverBus
+
+#define AKC_WATCH_STOPPED  0         // Dual-watch state: not running (see startDualWatch)
+#define AKC_WATCH_MAIN     1         // Dual-watch state: listening to the main channel
+#define AKC_WATCH_PRIORITY 2         // Dual-watch state: switched over to the active priority channel
+#define AKC_WATCH_STEP_IDLE    0     // Dual-watch step: listening (waiting for the next check)
+#define AKC_WATCH_STEP_HOP     1     // Dual-watch step: the muted priority image will be written
+#define AKC_WATCH_STEP_TRIGGER 2     // Dual-watch step: the tune process of the priority channel will be triggered
+#define AKC_WATCH_STEP_ADDRESS 3     // Dual-watch step: the address of the status block will be sent
+#define AKC_WATCH_STEP_READ    4     // Dual-watch step: the status block will be read
+#define AKC_WATCH_STEP_BACK    5     // Dual-watch step: the muted main image will be written
+#define AKC_WATCH_STEP_RETUNE  6     // Dual-watch step: the tune process of the main channel will be triggered
+#define AKC_WATCH_STEP_UNMUTE  7     // Dual-watch step: the audio will be unmuted
+#define AKC_WATCH_SETTLE_TIME 10000  // Time (in us) between a dual-watch tune trigger and the status read (or the unmute)
+
+#define AKC_BUTTON_NONE         0    // Button gesture: nothing happened (see AKC695XButton::process)
+#define AKC_BUTTON_CLICK        1    // Button gesture: single click
+#define AKC_BUTTON_DOUBLE_CLICK 2    // Button gesture: two clicks in AKC_BUTTON_DOUBLE_TIME
+#define AKC_BUTTON_LONG_PRESS   3    // Button gesture: held for AKC_BUTTON_LONG_TIME (reported while the button is still pressed)
+#define AKC_BUTTON_DEBOUNCE_TIME 30  // Default time (in ms) the button level must be stable
+#define AKC_BUTTON_DOUBLE_TIME  300  // Default maximum time (in ms) between the release of the first click and the second click
+#define AKC_BUTTON_LONG_TIME    800  // Default time (in ms) of a long press
+
+#define AKC_RAMP_LINEAR     0        // Volume ramp curve: constant speed (see rampVolume)
+#define AKC_RAMP_EASE_IN    1        // Volume ramp curve: starts slow and ends fast
+#define AKC_RAMP_EASE_OUT   2        // Volume ramp curve: starts fast and ends slow
+#define AKC_RAMP_SMOOTH     3        // Volume ramp curve: slow at both ends (smoothstep)
+#define AKC_RAMP_TIME       150      // Default time (in ms) of the soft mute and unmute ramps (see setRampTime)
+#define AKC_RAMP_MUTE_VOLUME 24      // Volume reached by softMute (the audio output is muted up to this volume)
+
+#define AKC_ATS_STOPPED  0           // ATS state: not running (see startAts)
+#define AKC_ATS_BAND     1           // ATS state: the next band will be set up
+#define AKC_ATS_TUNE     2           // ATS state: the registers of the next channel will be written
+#define AKC_ATS_TRIGGER  3           // ATS state: the tune process of the channel will be triggered
+#define AKC_ATS_ADDRESS  4           // ATS state: the address of the status block will be sent
+#define AKC_ATS_READ     5           // ATS state: the status block will be read
+#define AKC_ATS_MAX_PRESETS 24       // Maximum number of presets filled by the ATS
+#define AKC_ATS_GUARD    1           // Peaks up to this number of steps apart are the same station (the best one is kept)
+#define AKC_ATS_SETTLE_TIME 10000    // Time (in us) between the ATS tune trigger and the first status read
+
+#define AKC_AFC_INTERVAL      200    // Default time (in ms) between two reads of the frequency offset (see startAfc)
+#define AKC_AFC_HOLD_TIME     5000   // Default minimum time (in ms) between two AFC retunes
+#define AKC_AFC_SAMPLES       8      // Offset reads averaged before a decision (and weight 1/8 of the moving average)
+#define AKC_AFC_THRESHOLD     60     // Average offset (in % of the channel spacing) that makes the AFC retune
+#define AKC_AFC_MAX_CHANNELS  4      // Maximum AFC correction (in channels) around the current frequency
+
+#define AKC_TELEMETRY_SYNC        0xA7  // First byte of a telemetry page (see setTelemetry)
+#define AKC_TELEMETRY_PAGE_SIZE   64    // Default size (in bytes) of a telemetry page (a typical I2C EEPROM page)
+#define AKC_TELEMETRY_TIME_UNIT   100   // Time unit (in ms) of the telemetry timestamps
+#define AKC_TELEMETRY_HEADER      4     // Page header: sync, sequence number (2) and length of the records
+#define AKC_TELEMETRY_MAX_RECORD  16    // Maximum size (in bytes) of an encoded telemetry record
+#define AKC_TELEMETRY_KEYFRAME    0x80  // Record tag: absolute values (first record of each page)
+#define AKC_TELEMETRY_TUNED       0x40  // Record tag: tuned bit
+#define AKC_TELEMETRY_STEREO      0x20  // Record tag: stereo bit
+#define AKC_TELEMETRY_FM          0x01  // Keyframe tag: FM mode
+
+// Binary serial control protocol (see AKC695XLink)
+#define AKC_LINK_SYNC          0xA6    // First byte of a request or reply frame
+#define AKC_LINK_MAX_PAYLOAD   32      // Maximum payload of a request frame
+#define AKC_LINK_TIMEOUT       50      // Maximum time (in ms) between two bytes of a frame
+#define AKC_LINK_OK            0       // Reply result: all commands were executed
+#define AKC_LINK_CRC_ERROR     1       // Reply result: wrong CRC. Nothing was executed
+#define AKC_LINK_BAD_COMMAND   2       // Reply result: unknown command or missing arguments. Nothing was executed
+#define AKC_LINK_SET_FM        0x01    // Command: band, minimum (2), maximum (2), frequency (2), step. See setFM
+#define AKC_LINK_SET_AM        0x02    // Command: band, minimum (2), maximum (2), frequency (2), step. See setAM
+#define AKC_LINK_SET_FREQUENCY 0x03    // Command: frequency (2)
+#define AKC_LINK_SET_VOLUME    0x04    // Command: volume
+#define AKC_LINK_SEEK          0x05    // Command: direction (1 = up; 0 = down). Bad command if AKC695X_USE_SEEK = 0.
+#define AKC_LINK_SET_REGISTER  0x06    // Command: register, value
+#define AKC_LINK_FREQUENCY_UP  0x07    // Command: no arguments
+#define AKC_LINK_FREQUENCY_DOWN 0x08   // Command: no arguments
+#define AKC_LINK_STATUS        0x09    // Command: no arguments. Just gets the status (the status is sent in every reply)
+
+#define AKC_LATENCY_BUCKETS 12      // Number of log2 buckets of the latency histograms: < 1ms, 1ms, 2ms, 4ms ... >= 1024ms
+#define AKC_LATENCY_STC     0       // Latency from the tune or seek trigger to STC = 1 (see getLatencyPercentile)
+#define AKC_LATENCY_TUNED   1       // Latency from STC = 1 to tuned = 1
+
+// API ids used by the trace markers. Values from 32 to 63 are free for your sketch (see traceMark).
+#define AKC_API_SETUP          1
+#define AKC_API_SET_FM         2
+#define AKC_API_SET_AM         3
+#define AKC_API_SET_FREQUENCY  4
+#define AKC_API_SEEK_STATION   5
+#define AKC_API_SET_AUDIO      6
+#define AKC_API_SET_VOLUME     7
+#define AKC_API_GET_RSSI       8
+#define AKC_API_SIGNAL_CACHE   9
+
 /**
  * @brief AKC695X features
  * @details the table below shows some features fo the AKC695X devices family
@@ -88,6 +216,9 @@
 #define REG11 0x0B
 #define REG12 0x0C
 #define REG13 0x0D
+#define AKC_WRITE_GUARD_TIME 3000   // Time (in us) the device needs after a register write
+#define AKC_READ_GUARD_TIME  2000   // Time (in us) the device needs after a register read
+#define AKC_IMAGE_SIZE 14   // Number of RW registers kept in the cached register image (REG00 to REG13)
 // Read only AKC695X registers
 #define REG20 0x14
 #define REG21 0x15
@@ -140,7 +271,7 @@ typedef union {
     struct
     {
         uint8_t fmband : 3; //!<
-        uint8_t amband : 4; //!<
+        uint8_t amband : 5; //!<
     } refined;
     uint8_t raw;
 } akc595x_reg1;
@@ -413,6 +544,7 @@ typedef union {
  * @details When the frequency offset indicated, complement format, greater than 127, 256 can be reduced to normal values, attention here to 1kHz units FM, AM in units of 100Hz
  *
  * @see AKC6955 stereo FM / TV / MW / SW / LW digital tuning radio documentation; page 15
+ * @see AKC695X::startAfc
  */
 typedef uint8_t akc595x_reg26; //!<   When the frequency offset indicated, complement format, greater than 127, 256 can be
 
@@ -434,6 +566,524 @@ typedef union {
     uint8_t raw;
 } akc595x_reg27;
 
+/**
+ * @ingroup GA01
+ * @brief Register field descriptor
+ * @details Describes a field of a register by its address (REG), bit offset (OFFSET) and width (WIDTH), all known at compile time.
+ * @details The layout of the bitfields used by the unions above depends on the compiler, and the read-modify-write of a
+ * @details bitfield is not well optimized on AVR. The descriptor uses explicit masks and shifts instead. So, the code is the same
+ * @details on the Arduino and on the host, and a field update is a single AND / OR.
+ * @details get and set work on a raw register value. getFrom and setIn work on a register file (an array indexed by the register
+ * @details address like the register image of AKC695X). The offset, the width and the value range are checked at compile time.
+ * @details Use akc_fields to update several fields of the same register in one operation.
+ *
+ * @code
+ * uint8_t reg0 = akc_reg0_tune::set(value, 1);      // Sets just the tune bit
+ * uint8_t volume = akc_reg6_volume::get(value);     // Extracts the volume field
+ * @endcode
+ *
+ * @see akc_fields
+ */
+template <uint8_t REG, uint8_t OFFSET, uint8_t WIDTH>
+struct akc_field
+{
+    static_assert(WIDTH > 0 && (OFFSET + WIDTH) <= 8, "the field must fit in a 8 bits register");
+
+    static constexpr uint8_t reg = REG;                                          //!< Register address
+    static constexpr uint8_t offset = OFFSET;                                    //!< First bit of the field
+    static constexpr uint8_t width = WIDTH;                                      //!< Number of bits of the field
+    static constexpr uint8_t mask = (uint8_t)(((1U << WIDTH) - 1U) << OFFSET);   //!< Bits of the field in the register
+
+    //! Value of the field placed on its position (the bits out of the field are discarded)
+    static constexpr uint8_t encode(uint8_t value) { return (uint8_t)((value << OFFSET) & mask); }
+    //! Gets the field from a raw register value
+    static constexpr uint8_t get(uint8_t raw) { return (uint8_t)((raw & mask) >> OFFSET); }
+    //! Returns the raw register value with the field changed
+    static constexpr uint8_t set(uint8_t raw, uint8_t value) { return (uint8_t)((raw & (uint8_t)~mask) | encode(value)); }
+    //! Gets the field from a register file
+    static inline uint8_t getFrom(const uint8_t *file) { return get(file[REG]); }
+    //! Changes the field in a register file
+    static inline void setIn(uint8_t *file, uint8_t value) { file[REG] = set(file[REG], value); }
+};
+
+/**
+ * @ingroup GA01
+ * @brief Fields of the same register updated together
+ * @details Combines the masks of several akc_field of the same register at compile time. set writes all fields with a single
+ * @details AND / OR (one value per field, in the same order). Fields of other registers or overlapped fields do not compile.
+ *
+ * @code
+ * // REG00: power on, FM mode and tune trigger. The other bits of value are kept.
+ * value = akc_fields<akc_reg0_power_on, akc_reg0_fm_en, akc_reg0_tune>::set(value, 1, 1, 1);
+ * @endcode
+ *
+ * @see akc_field
+ */
+template <typename... FIELDS>
+struct akc_fields;
+
+template <typename FIELD>
+struct akc_fields<FIELD>
+{
+    static constexpr uint8_t reg = FIELD::reg;
+    static constexpr uint8_t mask = FIELD::mask;
+
+    static constexpr uint8_t encode(uint8_t value) { return FIELD::encode(value); }
+    static constexpr uint8_t set(uint8_t raw, uint8_t value) { return FIELD::set(raw, value); }
+};
+
+template <typename FIELD, typename... OTHERS>
+struct akc_fields<FIELD, OTHERS...>
+{
+    static_assert(FIELD::reg == akc_fields<OTHERS...>::reg, "all fields must belong to the same register");
+    static_assert((FIELD::mask & akc_fields<OTHERS...>::mask) == 0, "overlapped fields");
+
+    static constexpr uint8_t reg = FIELD::reg;
+    static constexpr uint8_t mask = FIELD::mask | akc_fields<OTHERS...>::mask;
+
+    template <typename... VALUES>
+    static constexpr uint8_t encode(uint8_t value, VALUES... values)
+    {
+        return (uint8_t)(FIELD::encode(value) | akc_fields<OTHERS...>::encode(values...));
+    }
+
+    template <typename... VALUES>
+    static constexpr uint8_t set(uint8_t raw, VALUES... values)
+    {
+        static_assert(sizeof...(VALUES) == sizeof...(OTHERS) + 1, "one value for each field");
+        return (uint8_t)((raw & (uint8_t)~mask) | encode(values...));
+    }
+};
+
+/**
+ * @ingroup GA01
+ * @brief Field descriptors of a register in the order of the bit-fields of its union
+ * @details The bit-fields of the unions akc595x_regN are allocated from the least significant bit, so each field starts
+ * @details where the previous one ends (packed). ones returns the refined struct of the union with all fields set to 1s,
+ * @details truncated to the width of each bit-field (see akc_check_unions).
+ */
+template <typename... FIELDS>
+struct akc_layout;
+
+template <>
+struct akc_layout<>
+{
+    static constexpr bool packed(uint8_t offset) { return offset == 8; }
+};
+
+template <typename FIELD, typename... OTHERS>
+struct akc_layout<FIELD, OTHERS...>
+{
+    //! true if FIELD starts at offset and the other fields follow it up to the last bit of the register
+    static constexpr bool packed(uint8_t offset = 0)
+    {
+        return FIELD::offset == offset && akc_layout<OTHERS...>::packed(offset + FIELD::width);
+    }
+
+    //! Refined struct with all bit-fields set to 0xFF (one initializer per field)
+    template <typename T>
+    static constexpr T ones(uint8_t value = 0xFF) { return T{value, (uint8_t)(value | (OTHERS::mask & 0))...}; }
+};
+
+/**
+ * @ingroup GA01
+ * @brief Field descriptors of the registers
+ * @details akc_regN_field describes the bit-field refined.field of the union akc595x_regN. Both layouts are checked against each
+ * @details other at compile time (see akc_check_unions). amband of akc595x_reg1 is 5 bits wide (bits 3 to 7), as in the Datasheet.
+ */
+typedef akc_field<REG00, 0, 2> akc_reg0_rsv;
+typedef akc_field<REG00, 2, 1> akc_reg0_mute;
+typedef akc_field<REG00, 3, 1> akc_reg0_seekup;
+typedef akc_field<REG00, 4, 1> akc_reg0_seek;
+typedef akc_field<REG00, 5, 1> akc_reg0_tune;
+typedef akc_field<REG00, 6, 1> akc_reg0_fm_en;
+typedef akc_field<REG00, 7, 1> akc_reg0_power_on;
+
+typedef akc_field<REG01, 0, 3> akc_reg1_fmband;
+typedef akc_field<REG01, 3, 5> akc_reg1_amband;
+
+typedef akc_field<REG02, 0, 5> akc_reg2_channel;
+typedef akc_field<REG02, 5, 1> akc_reg2_mode3k;
+typedef akc_field<REG02, 6, 1> akc_reg2_ref_32k_mode;
+typedef akc_field<REG02, 7, 1> akc_reg2_rsv;
+
+typedef akc_field<REG06, 0, 1> akc_reg6_phase_inv;
+typedef akc_field<REG06, 1, 1> akc_reg6_line;
+typedef akc_field<REG06, 2, 6> akc_reg6_volume;
+
+typedef akc_field<REG07, 0, 2> akc_reg7_bw;
+typedef akc_field<REG07, 2, 2> akc_reg7_stereo_mono;
+typedef akc_field<REG07, 4, 1> akc_reg7_bben;
+typedef akc_field<REG07, 5, 1> akc_reg7_de;
+typedef akc_field<REG07, 6, 2> akc_reg7_rsv;
+
+typedef akc_field<REG08, 0, 2> akc_reg8_stereo_th;
+typedef akc_field<REG08, 2, 2> akc_reg8_fd_th;
+typedef akc_field<REG08, 4, 2> akc_reg8_am_cnr_th;
+typedef akc_field<REG08, 6, 2> akc_reg8_fm_cnr_th;
+
+typedef akc_field<REG09, 0, 1> akc_reg9_iv_en;
+typedef akc_field<REG09, 1, 1> akc_reg9_rsv1;
+typedef akc_field<REG09, 2, 1> akc_reg9_osc_en;
+typedef akc_field<REG09, 3, 1> akc_reg9_pd_adc_vol;
+typedef akc_field<REG09, 4, 4> akc_reg9_rsv2;
+
+typedef akc_field<REG11, 0, 2> akc_reg11_rsv1;
+typedef akc_field<REG11, 2, 2> akc_reg11_space;
+typedef akc_field<REG11, 4, 4> akc_reg11_rsv2;
+
+typedef akc_field<REG12, 0, 5> akc_reg12_rsv2;
+typedef akc_field<REG12, 5, 1> akc_reg12_pd_rx;
+typedef akc_field<REG12, 6, 1> akc_reg12_res;
+typedef akc_field<REG12, 7, 1> akc_reg12_pd_adc;
+
+typedef akc_field<REG13, 0, 2> akc_reg13_rsv3;
+typedef akc_field<REG13, 2, 2> akc_reg13_vol_pre;
+typedef akc_field<REG13, 4, 2> akc_reg13_rsv2;
+typedef akc_field<REG13, 6, 1> akc_reg13_st_led;
+typedef akc_field<REG13, 7, 1> akc_reg13_rsv1;
+
+typedef akc_field<REG20, 0, 5> akc_reg20_readchan;
+typedef akc_field<REG20, 5, 1> akc_reg20_tuned;
+typedef akc_field<REG20, 6, 1> akc_reg20_stc;
+typedef akc_field<REG20, 7, 1> akc_reg20_st;
+
+typedef akc_field<REG22, 0, 7> akc_reg22_cnram;
+typedef akc_field<REG22, 7, 1> akc_reg22_mode3k_f;
+
+typedef akc_field<REG23, 0, 7> akc_reg23_cnrfm;
+typedef akc_field<REG23, 7, 1> akc_reg23_st_dem;
+
+typedef akc_field<REG24, 0, 1> akc_reg24_lvmode;
+typedef akc_field<REG24, 1, 1> akc_reg24_rsv;
+typedef akc_field<REG24, 2, 3> akc_reg24_pgalevel_if;
+typedef akc_field<REG24, 5, 3> akc_reg24_pgalevel_rf;
+
+typedef akc_field<REG25, 0, 6> akc_reg25_vbat;
+typedef akc_field<REG25, 6, 2> akc_reg25_rsv;
+
+typedef akc_field<REG27, 0, 7> akc_reg27_rssi;
+typedef akc_field<REG27, 7, 1> akc_reg27_rsv;
+
+// Layout checks: the fields of each register must cover the 8 bits without overlapping (see akc_fields) and
+// some well known bits of the Datasheet must be on the right place.
+static_assert(akc_fields<akc_reg0_rsv, akc_reg0_mute, akc_reg0_seekup, akc_reg0_seek, akc_reg0_tune, akc_reg0_fm_en, akc_reg0_power_on>::mask == 0xFF, "REG00 layout");
+static_assert(akc_fields<akc_reg1_fmband, akc_reg1_amband>::mask == 0xFF, "REG01 layout");
+static_assert(akc_fields<akc_reg2_channel, akc_reg2_mode3k, akc_reg2_ref_32k_mode, akc_reg2_rsv>::mask == 0xFF, "REG02 layout");
+static_assert(akc_fields<akc_reg6_phase_inv, akc_reg6_line, akc_reg6_volume>::mask == 0xFF, "REG06 layout");
+static_assert(akc_fields<akc_reg7_bw, akc_reg7_stereo_mono, akc_reg7_bben, akc_reg7_de, akc_reg7_rsv>::mask == 0xFF, "REG07 layout");
+static_assert(akc_fields<akc_reg8_stereo_th, akc_reg8_fd_th, akc_reg8_am_cnr_th, akc_reg8_fm_cnr_th>::mask == 0xFF, "REG08 layout");
+static_assert(akc_fields<akc_reg9_iv_en, akc_reg9_rsv1, akc_reg9_osc_en, akc_reg9_pd_adc_vol, akc_reg9_rsv2>::mask == 0xFF, "REG09 layout");
+static_assert(akc_fields<akc_reg11_rsv1, akc_reg11_space, akc_reg11_rsv2>::mask == 0xFF, "REG11 layout");
+static_assert(akc_fields<akc_reg12_rsv2, akc_reg12_pd_rx, akc_reg12_res, akc_reg12_pd_adc>::mask == 0xFF, "REG12 layout");
+static_assert(akc_fields<akc_reg13_rsv3, akc_reg13_vol_pre, akc_reg13_rsv2, akc_reg13_st_led, akc_reg13_rsv1>::mask == 0xFF, "REG13 layout");
+static_assert(akc_fields<akc_reg20_readchan, akc_reg20_tuned, akc_reg20_stc, akc_reg20_st>::mask == 0xFF, "REG20 layout");
+static_assert(akc_fields<akc_reg22_cnram, akc_reg22_mode3k_f>::mask == 0xFF, "REG22 layout");
+static_assert(akc_fields<akc_reg23_cnrfm, akc_reg23_st_dem>::mask == 0xFF, "REG23 layout");
+static_assert(akc_fields<akc_reg24_lvmode, akc_reg24_rsv, akc_reg24_pgalevel_if, akc_reg24_pgalevel_rf>::mask == 0xFF, "REG24 layout");
+static_assert(akc_fields<akc_reg25_vbat, akc_reg25_rsv>::mask == 0xFF, "REG25 layout");
+static_assert(akc_fields<akc_reg27_rssi, akc_reg27_rsv>::mask == 0xFF, "REG27 layout");
+static_assert(akc_reg0_tune::mask == 0x20 && akc_reg0_power_on::mask == 0x80, "REG00 tune and power_on bits");
+static_assert(akc_reg20_stc::mask == 0x40 && akc_reg20_tuned::mask == 0x20, "REG20 stc and tuned bits");
+static_assert(akc_reg23_st_dem::mask == 0x80, "REG23 st_dem bit");
+static_assert(akc_fields<akc_reg0_power_on, akc_reg0_fm_en, akc_reg0_tune>::set(0x04, 1, 1, 1) == 0xE4, "akc_fields::set");
+static_assert(akc_reg6_volume::set(0xFF, 24) == 0x63 && akc_reg6_volume::get(0x63) == 24, "akc_field::set and get");
+
+/**
+ * @ingroup GA01
+ * @brief Compile-time checks of the field descriptors against the unions akc595x_reg0 to akc595x_reg27
+ * @details Each descriptor must be on the position of its bit-field (packed, in the same order) and have its width (a bit-field
+ * @details set to 1s must read as the 1s of the descriptor). Never called: the checks are the static_asserts.
+ */
+inline void akc_check_unions()
+{
+    typedef akc_layout<akc_reg0_rsv, akc_reg0_mute, akc_reg0_seekup, akc_reg0_seek, akc_reg0_tune, akc_reg0_fm_en, akc_reg0_power_on> reg0;
+    typedef akc_layout<akc_reg1_fmband, akc_reg1_amband> reg1;
+    typedef akc_layout<akc_reg2_channel, akc_reg2_mode3k, akc_reg2_ref_32k_mode, akc_reg2_rsv> reg2;
+    typedef akc_layout<akc_reg6_phase_inv, akc_reg6_line, akc_reg6_volume> reg6;
+    typedef akc_layout<akc_reg7_bw, akc_reg7_stereo_mono, akc_reg7_bben, akc_reg7_de, akc_reg7_rsv> reg7;
+    typedef akc_layout<akc_reg8_stereo_th, akc_reg8_fd_th, akc_reg8_am_cnr_th, akc_reg8_fm_cnr_th> reg8;
+    typedef akc_layout<akc_reg9_iv_en, akc_reg9_rsv1, akc_reg9_osc_en, akc_reg9_pd_adc_vol, akc_reg9_rsv2> reg9;
+    typedef akc_layout<akc_reg11_rsv1, akc_reg11_space, akc_reg11_rsv2> reg11;
+    typedef akc_layout<akc_reg12_rsv2, akc_reg12_pd_rx, akc_reg12_res, akc_reg12_pd_adc> reg12;
+    typedef akc_layout<akc_reg13_rsv3, akc_reg13_vol_pre, akc_reg13_rsv2, akc_reg13_st_led, akc_reg13_rsv1> reg13;
+    typedef akc_layout<akc_reg20_readchan, akc_reg20_tuned, akc_reg20_stc, akc_reg20_st> reg20;
+    typedef akc_layout<akc_reg22_cnram, akc_reg22_mode3k_f> reg22;
+    typedef akc_layout<akc_reg23_cnrfm, akc_reg23_st_dem> reg23;
+    typedef akc_layout<akc_reg24_lvmode, akc_reg24_rsv, akc_reg24_pgalevel_if, akc_reg24_pgalevel_rf> reg24;
+    typedef akc_layout<akc_reg25_vbat, akc_reg25_rsv> reg25;
+    typedef akc_layout<akc_reg27_rssi, akc_reg27_rsv> reg27;
+
+    constexpr decltype(akc595x_reg0::refined) r0 = reg0::ones<decltype(akc595x_reg0::refined)>();
+    constexpr decltype(akc595x_reg1::refined) r1 = reg1::ones<decltype(akc595x_reg1::refined)>();
+    constexpr decltype(akc595x_reg2::refined) r2 = reg2::ones<decltype(akc595x_reg2::refined)>();
+    constexpr decltype(akc595x_reg6::refined) r6 = reg6::ones<decltype(akc595x_reg6::refined)>();
+    constexpr decltype(akc595x_reg7::refined) r7 = reg7::ones<decltype(akc595x_reg7::refined)>();
+    constexpr decltype(akc595x_reg8::refined) r8 = reg8::ones<decltype(akc595x_reg8::refined)>();
+    constexpr decltype(akc595x_reg9::refined) r9 = reg9::ones<decltype(akc595x_reg9::refined)>();
+    constexpr decltype(akc595x_reg11::refined) r11 = reg11::ones<decltype(akc595x_reg11::refined)>();
+    constexpr decltype(akc595x_reg12::refined) r12 = reg12::ones<decltype(akc595x_reg12::refined)>();
+    constexpr decltype(akc595x_reg13::refined) r13 = reg13::ones<decltype(akc595x_reg13::refined)>();
+    constexpr decltype(akc595x_reg20::refined) r20 = reg20::ones<decltype(akc595x_reg20::refined)>();
+    constexpr decltype(akc595x_reg22::refined) r22 = reg22::ones<decltype(akc595x_reg22::refined)>();
+    constexpr decltype(akc595x_reg23::refined) r23 = reg23::ones<decltype(akc595x_reg23::refined)>();
+    constexpr decltype(akc595x_reg24::refined) r24 = reg24::ones<decltype(akc595x_reg24::refined)>();
+    constexpr decltype(akc595x_reg25::refined) r25 = reg25::ones<decltype(akc595x_reg25::refined)>();
+    constexpr decltype(akc595x_reg27::refined) r27 = reg27::ones<decltype(akc595x_reg27::refined)>();
+
+    static_assert(reg0::packed() && r0.rsv == akc_reg0_rsv::get(0xFF) && r0.mute == akc_reg0_mute::get(0xFF) &&
+                      r0.seekup == akc_reg0_seekup::get(0xFF) && r0.seek == akc_reg0_seek::get(0xFF) && r0.tune == akc_reg0_tune::get(0xFF) &&
+                      r0.fm_en == akc_reg0_fm_en::get(0xFF) && r0.power_on == akc_reg0_power_on::get(0xFF),
+                  "akc595x_reg0 and akc_reg0_* differ");
+    static_assert(reg1::packed() && r1.fmband == akc_reg1_fmband::get(0xFF) && r1.amband == akc_reg1_amband::get(0xFF),
+                  "akc595x_reg1 and akc_reg1_* differ");
+    static_assert(reg2::packed() && r2.channel == akc_reg2_channel::get(0xFF) && r2.mode3k == akc_reg2_mode3k::get(0xFF) &&
+                      r2.ref_32k_mode == akc_reg2_ref_32k_mode::get(0xFF) && r2.rsv == akc_reg2_rsv::get(0xFF),
+                  "akc595x_reg2 and akc_reg2_* differ");
+    static_assert(reg6::packed() && r6.phase_inv == akc_reg6_phase_inv::get(0xFF) && r6.line == akc_reg6_line::get(0xFF) &&
+                      r6.volume == akc_reg6_volume::get(0xFF),
+                  "akc595x_reg6 and akc_reg6_* differ");
+    static_assert(reg7::packed() && r7.bw == akc_reg7_bw::get(0xFF) && r7.stereo_mono == akc_reg7_stereo_mono::get(0xFF) &&
+                      r7.bben == akc_reg7_bben::get(0xFF) && r7.de == akc_reg7_de::get(0xFF) && r7.rsv == akc_reg7_rsv::get(0xFF),
+                  "akc595x_reg7 and akc_reg7_* differ");
+    static_assert(reg8::packed() && r8.stereo_th == akc_reg8_stereo_th::get(0xFF) && r8.fd_th == akc_reg8_fd_th::get(0xFF) &&
+                      r8.am_cnr_th == akc_reg8_am_cnr_th::get(0xFF) && r8.fm_cnr_th == akc_reg8_fm_cnr_th::get(0xFF),
+                  "akc595x_reg8 and akc_reg8_* differ");
+    static_assert(reg9::packed() && r9.iv_en == akc_reg9_iv_en::get(0xFF) && r9.rsv1 == akc_reg9_rsv1::get(0xFF) &&
+                      r9.osc_en == akc_reg9_osc_en::get(0xFF) && r9.pd_adc_vol == akc_reg9_pd_adc_vol::get(0xFF) &&
+                      r9.rsv2 == akc_reg9_rsv2::get(0xFF),
+                  "akc595x_reg9 and akc_reg9_* differ");
+    static_assert(reg11::packed() && r11.rsv1 == akc_reg11_rsv1::get(0xFF) && r11.space == akc_reg11_space::get(0xFF) &&
+                      r11.rsv2 == akc_reg11_rsv2::get(0xFF),
+                  "akc595x_reg11 and akc_reg11_* differ");
+    static_assert(reg12::packed() && r12.rsv2 == akc_reg12_rsv2::get(0xFF) && r12.pd_rx == akc_reg12_pd_rx::get(0xFF) &&
+                      r12.res == akc_reg12_res::get(0xFF) && r12.pd_adc == akc_reg12_pd_adc::get(0xFF),
+                  "akc595x_reg12 and akc_reg12_* differ");
+    static_assert(reg13::packed() && r13.rsv3 == akc_reg13_rsv3::get(0xFF) && r13.vol_pre == akc_reg13_vol_pre::get(0xFF) &&
+                      r13.rsv2 == akc_reg13_rsv2::get(0xFF) && r13.st_led == akc_reg13_st_led::get(0xFF) &&
+                      r13.rsv1 == akc_reg13_rsv1::get(0xFF),
+                  "akc595x_reg13 and akc_reg13_* differ");
+    static_assert(reg20::packed() && r20.readchan == akc_reg20_readchan::get(0xFF) && r20.tuned == akc_reg20_tuned::get(0xFF) &&
+                      r20.stc == akc_reg20_stc::get(0xFF) && r20.st == akc_reg20_st::get(0xFF),
+                  "akc595x_reg20 and akc_reg20_* differ");
+    static_assert(reg22::packed() && r22.cnram == akc_reg22_cnram::get(0xFF) && r22.mode3k_f == akc_reg22_mode3k_f::get(0xFF),
+                  "akc595x_reg22 and akc_reg22_* differ");
+    static_assert(reg23::packed() && r23.cnrfm == akc_reg23_cnrfm::get(0xFF) && r23.st_dem == akc_reg23_st_dem::get(0xFF),
+                  "akc595x_reg23 and akc_reg23_* differ");
+    static_assert(reg24::packed() && r24.lvmode == akc_reg24_lvmode::get(0xFF) && r24.rsv == akc_reg24_rsv::get(0xFF) &&
+                      r24.pgalevel_if == akc_reg24_pgalevel_if::get(0xFF) && r24.pgalevel_rf == akc_reg24_pgalevel_rf::get(0xFF),
+                  "akc595x_reg24 and akc_reg24_* differ");
+    static_assert(reg25::packed() && r25.vbat == akc_reg25_vbat::get(0xFF) && r25.rsv == akc_reg25_rsv::get(0xFF),
+                  "akc595x_reg25 and akc_reg25_* differ");
+    static_assert(reg27::packed() && r27.rssi == akc_reg27_rssi::get(0xFF) && r27.rsv == akc_reg27_rsv::get(0xFF),
+                  "akc595x_reg27 and akc_reg27_* differ");
+}
+
+/**
+ * @ingroup GA01
+ * @brief Signal quality cache entry
+ * @details Stores the last signal quality measured on a given channel (mode, band and channel).
+ * @details You have to declare an array of this type in your sketch and pass it to AKC695X::setSignalCache.
+ * @details The library does not allocate memory for the cache.
+ *
+ * @see AKC695X::setSignalCache, AKC695X::getCachedSignal
+ */
+typedef struct
+{
+    uint8_t key;        //!< bit 7 = mode (1 = FM; 0 = AM); bits 0 to 6 = band
+    uint16_t channel;   //!< Channel number (see akc595x_reg2 and akc595x_reg3)
+    int8_t rssi;        //!< RSSI measured on this channel (see AKC695X::getRSSI)
+    uint8_t cnr : 7;    //!< Carrier to noise ratio in dB (FM or AM)
+    uint8_t stereo : 1; //!< 1 = FM stereo detected
+    uint32_t timestamp; //!< millis() value when the signal was measured
+} akc_signal_cache;
+
+/**
+ * @ingroup GA01
+ * @brief I2C trace record
+ * @details Each register operation (read or write) is stored in 4 bytes. The same format is used in the RAM buffer and on the stream.
+ * @details The delta field is the time elapsed since the previous record in AKC_TRACE_TIME_UNIT (16us) units.
+ * @details It saturates at 0xFFFF (about 1s). On the stream, the delta field is sent little-endian.
+ *
+ * | Byte | Content                                                    |
+ * | ---- | ---------------------------------------------------------- |
+ * |  0   | bits 6 and 7 = operation (AKC_TRACE_WRITE, AKC_TRACE_READ or AKC_TRACE_MARK); bits 0 to 5 = register or API id |
+ * |  1   | register value (0 for markers)                             |
+ * |  2   | delta time (low byte)                                      |
+ * |  3   | delta time (high byte)                                     |
+ *
+ * @see AKC695X::setTraceBuffer, AKC695X::setTraceOutput, extras/tools/akc695x_trace.cpp
+ */
+typedef struct
+{
+    uint8_t op_reg;     //!< bits 6 and 7 = operation; bits 0 to 5 = register or API id
+    uint8_t value;      //!< register value
+    uint16_t delta;     //!< time since the previous record (AKC_TRACE_TIME_UNIT units)
+} akc_trace_record;
+
+/**
+ * @ingroup GA01
+ * @brief Boot time breakdown
+ * @details Filled by AKC695X::fastSetup. All values are in microseconds.
+ */
+typedef struct
+{
+    uint32_t reset;     //!< RESET pulse and wait for the device
+    uint32_t config;    //!< Writing the initial register image
+    uint32_t tune;      //!< From the tune trigger to the STC bit (the audio is available)
+    uint32_t total;     //!< From the beginning of fastSetup to the STC bit
+} akc_boot_timing;
+
+/**
+ * @ingroup GA01
+ * @brief Receiver configuration profile
+ * @details Captures a full register configuration (band, custom band, channel, audio, bandwidth, de-emphasis, stereo,
+ * @details CNR thresholds, seek spacing and volume) and the band information used by the library.
+ * @details It is a plain structure. You can store it in the EEPROM.
+ *
+ * @see AKC695X::saveProfile, AKC695X::applyProfile
+ */
+typedef struct
+{
+    uint8_t regs[AKC_IMAGE_SIZE];   //!< Content of the registers REG00 to REG13
+    uint16_t mask;                  //!< Registers defined by the profile (bit n = register n)
+    uint8_t mode;                   //!< 1 = FM; 0 = AM
+    uint8_t band;                   //!< FM or AM band (see setFM and setAM)
+    uint16_t minimum_frequency;     //!< Minimum frequency of the band
+    uint16_t maximum_frequency;     //!< Maximum frequency of the band
+    uint16_t frequency;             //!< Frequency
+    uint8_t step;                   //!< Increment and decrement step
+} akc_profile;
+
+/**
+ * @ingroup GA01
+ * @brief Native band plan entry
+ * @details Describes a native FM (0 to 7) or AM (0 to 17) band of the AKC695X. The band plan is stored in flash (PROGMEM).
+ * @details Use AKC695X::getBandPlan to copy one entry to RAM.
+ *
+ * @see AKC695X::getBandPlan, AKC695X::findBandPlan, AKC695X::useBandPlan
+ */
+typedef struct
+{
+    uint8_t mode_band;          //!< bit 7 = mode (1 = FM; 0 = AM); bits 0 to 6 = band (see setFM and setAM band tables)
+    uint16_t minimum_frequency; //!< Minimum frequency (FM: 100kHz units; AM: kHz)
+    uint16_t maximum_frequency; //!< Maximum frequency
+    uint8_t step;               //!< Default increment and decrement step
+    uint8_t space;              //!< FM: seek space (see setFmSeekStep); AM: 1 = 3K channel spacing; 0 = 5K channel spacing
+} akc_band_plan;
+
+/**
+ * @ingroup GA01
+ * @brief Scheduler task
+ * @details A periodic or one-shot job run by AKC695XScheduler. You have to declare an array of this type in your sketch.
+ * @details The statistics fields are updated by the scheduler. All times are in ms.
+ *
+ * @see AKC695XScheduler
+ */
+typedef struct
+{
+    void (*callback)();     //!< Function that does the job (NULL = free task)
+    uint32_t due;           //!< millis() value when the task has to run
+    uint16_t period;        //!< Period of the task. 0 = one-shot task
+    uint16_t deadline;      //!< Maximum lateness accepted. A late run is counted as a miss.
+    uint8_t priority;       //!< When more than one task is due, the highest priority runs first
+    uint8_t active;         //!< 1 = waiting to run; 0 = idle (one-shot task already run)
+    uint16_t runs;          //!< Number of runs
+    uint16_t misses;        //!< Number of runs after the deadline
+    uint16_t maxJitter;     //!< Maximum lateness
+    uint32_t sumJitter;     //!< Sum of the lateness of all runs (see AKC695XScheduler::getAverageJitter)
+} akc_task;
+
+/**
+ * @ingroup GA01
+ * @brief Queued I2C transaction
+ * @details Element of the transaction queue (see AKC695X::setTransactionQueue). You have to declare an array of this type in your sketch.
+ */
+typedef struct
+{
+    uint8_t op_reg;     //!< bit 7 = 1 read; 0 write; bits 0 to 6 = register
+    uint8_t value;      //!< value to be written
+} akc_transaction;
+
+/**
+ * @ingroup GA01
+ * @brief Tune latency histogram
+ * @details Element of the latency table (see AKC695X::setLatencyHistogram). You have to declare an array of this type in your sketch.
+ * @details Each element accumulates the latencies of one mode, band and kind of trigger (tune or seek).
+ * @details The bucket 0 counts the latencies shorter than 1ms. The bucket n counts the latencies from 2^(n-1) to 2^n - 1 ms.
+ * @details The last bucket counts the latencies from 1024ms. The counters stop at 65535.
+ */
+typedef struct
+{
+    uint8_t key;                            //!< bit 7 = mode (1 = FM); bit 6 = 1 seek, 0 tune; bits 0 to 5 = band; 0xFF = free element
+    uint16_t untuned;                       //!< Number of triggers followed by STC without tuned = 1 (no station)
+    uint16_t stc[AKC_LATENCY_BUCKETS];      //!< Trigger to STC = 1 histogram
+    uint16_t tuned[AKC_LATENCY_BUCKETS];    //!< STC = 1 to tuned = 1 histogram
+} akc_latency_histogram;
+
+/**
+ * @ingroup GA01
+ * @brief Preset (memory) used by the scanner
+ * @details The band must be in the native band plan (see AKC695X::getBandPlanIndex).
+ */
+typedef struct
+{
+    uint8_t mode_band;      //!< bit 7 = mode (1 = FM; 0 = AM); bits 0 to 6 = band (same as akc_band_plan)
+    uint16_t frequency;     //!< Frequency (FM: 100kHz units; AM: kHz)
+} akc_preset;
+
+/**
+ * @ingroup GA01
+ * @brief Receiver status snapshot
+ * @details Built from a single burst read of the status block (see AKC695X::getStatus). Several parts of your sketch can
+ * @details share the same snapshot instead of reading the device again.
+ */
+typedef struct
+{
+    uint8_t regs[8];        //!< REG20 to REG27
+    uint16_t frequency;     //!< Tuned frequency (current mode unit) calculated from the channel of REG20 and REG21
+    int8_t rssi;            //!< Signal level in dBuV (same calculation of getRSSI)
+    uint8_t cnr;            //!< Carrier to noise ratio in dB (FM or AM, depending on the current mode)
+    uint8_t stc : 1;        //!< 1 = tune or seek process completed
+    uint8_t tuned : 1;      //!< 1 = tuned on a station
+    uint8_t stereo : 1;     //!< 1 = FM stereo
+    uint32_t timestamp;     //!< millis() value of the read
+} akc_status;
+
+/**
+ * @ingroup GA01
+ * @brief I2C error counters
+ * @details The counters saturate at 65535. Use AKC695X::clearBusErrors to reset them.
+ *
+ * @see AKC695X::getBusErrors, AKC695X::setBusRetries
+ */
+typedef struct
+{
+    uint16_t nack;          //!< Address or data not acknowledged (AKC_BUS_NACK_ADDRESS and AKC_BUS_NACK_DATA)
+    uint16_t timeout;       //!< Bus timeouts and other bus errors (AKC_BUS_TIMEOUT and AKC_BUS_OTHER)
+    uint16_t short_read;    //!< Reads that got less bytes than requested (AKC_BUS_SHORT_READ)
+    uint16_t retries;       //!< Transactions repeated
+    uint16_t recoveries;    //!< Bus recovery sequences (see AKC695X::recoverBus)
+    uint16_t failures;      //!< Transactions abandoned after all retries
+    uint8_t last;           //!< Last error (AKC_BUS_NACK_ADDRESS to AKC_BUS_SHORT_READ)
+} akc_bus_errors;
+
+/**
+ * @ingroup GA01
+ * @brief Telemetry sample
+ * @details One sample of the reception monitor (see AKC695X::setTelemetry). All fields come from a single burst read of the
+ * @details status block.
+ */
+typedef struct
+{
+    uint32_t time;          //!< Time since startTelemetry in AKC_TELEMETRY_TIME_UNIT units
+    uint16_t frequency;     //!< Tuned frequency (FM: 100kHz units; AM: kHz)
+    int8_t rssi;            //!< Signal level in dBuV (same calculation of getRSSI)
+    uint8_t cnr;            //!< Carrier to noise ratio in dB
+    uint8_t vbat;           //!< Supply voltage field of REG25 (millivolts = 1800 + 50 * vbat)
+    uint8_t flags;          //!< AKC_TELEMETRY_FM, AKC_TELEMETRY_STEREO and AKC_TELEMETRY_TUNED
+} akc_telemetry_sample;
+
 /**
  * @defgroup GA02 AKC695X Class
  * @brief AKC695X Class
@@ -446,23 +1096,298 @@ class AKC695X
 {
 
 protected:
-    int deviceAddress = AKC695X_I2C_ADRESS;
-    int resetPin = -1;
+    uint8_t deviceAddress = AKC695X_I2C_ADRESS;
+    int8_t resetPin = -1;
+    uint8_t busResult = AKC_BUS_OK;             //!< Result of the last I2C transaction (see getBusResult)
 
     uint8_t volume;                             //!< Store the current volume
-    uint16_t currentStep;                       //!< Strore the current step
+    uint8_t currentStep;                        //!< Strore the current step
     uint16_t currentFrequency;                  //!< Store the current frequency
     uint8_t currentMode = 0;                    //!< Store the current mode: 1 = FM; 0 = AM
     uint8_t currentCrystalType = CRYSTAL_32KHz; //!< Store the crystal type used:  0 = 12MHz;   1 = 32.768kHz
     uint8_t currentMode3k = 0;                  //!<  1 =  3K; 0 = AM
 
-    // AM current band information
+    // Current band information (FM or AM)
     uint8_t currentBand = 0;
     uint16_t currentBandMinimumFrequency;
     uint16_t currentBandMaximumFrequency;
+    uint8_t tuneMute = 0;                       //!< Mute bit of the REG00 writes of setFM, setAM and the tune process (see scannerHop)
+
+    // Cached register image. Updated on every write and read of the RW registers (see setRegister and getRegister).
+    uint8_t regImage[AKC_IMAGE_SIZE];   //!< Last known content of the registers REG00 to REG13
+    uint16_t regImageValid = 0;         //!< bit n = 1 if regImage[n] is known
+
+    void busBegin();
+    uint8_t busWrite(uint8_t reg, const uint8_t *values, uint8_t count);
+    uint8_t busRead(uint8_t *values, uint8_t count);
+    uint8_t busDone(uint8_t result);
+    bool busTransfer(uint8_t reg, const uint8_t *out, uint8_t out_count, uint8_t *in, uint8_t in_count);
+    bool busRetry(uint8_t result, uint8_t attempt);
+
+    void updateRegisterImage(uint8_t reg, uint8_t value);
+    void registerWritten(uint8_t reg, uint8_t value);
+    void registerRead(uint8_t reg, uint8_t value);
+    void completeRegisterImage();
+    void writeRegisterImage(const uint8_t *image, uint16_t mask);
+
+    uint16_t frequencyToChannel(uint16_t frequency);
+    int calculateRSSI(uint8_t reg24, uint8_t reg27, uint16_t frequency);
+    void prepareTuneImage(uint16_t frequency, uint8_t *image);
+    void tuneChannel(uint16_t channel);
+
+#if AKC695X_USE_BUS_RECOVERY
+    // I2C error handling (see setBusRetries)
+    uint8_t busRetries = AKC_BUS_RETRIES;   //!< Number of times a failed transaction is repeated
+    akc_bus_errors busErrors = {};          //!< Error counters
+#endif
+
+#if AKC695X_USE_TRANSACTION
+    bool transactionOpen = false;       //!< true between beginTransaction and commitTransaction
+    bool transactionTune = false;       //!< true if the tune process has to be triggered by commitTransaction
+    uint16_t regDirty = 0;              //!< bit n = 1 if regImage[n] has to be written by commitTransaction
+#endif
+
+#if AKC695X_USE_STANDBY
+    uint8_t standbyReg00;               //!< REG00 content before standby
+    uint8_t standbyReg12;               //!< REG12 content before standby
+    bool standbyMode = false;           //!< true if the device is in standby (see standby and resume)
+#endif
+
+#if AKC695X_USE_PROFILES
+    // Band stacking (see setBandStack)
+    akc_profile *bandStack = NULL;          //!< One profile per band, declared in your sketch
+    uint8_t bandStackSize = 0;              //!< Number of elements of bandStack
+    int8_t bandStackCurrent = -1;           //!< Band in use (-1 = none)
+#endif
+
+#if AKC695X_USE_SIGNAL_CACHE
+    // Signal quality cache (see setSignalCache)
+    akc_signal_cache *signalCache = NULL;   //!< Points to the array declared in your sketch
+    uint8_t signalCacheSize = 0;            //!< Number of elements of the signalCache array
+    uint8_t signalCacheCount = 0;           //!< Number of elements in use. The most recently used is the first one.
+    uint16_t signalCacheMaxAge = 0;         //!< Time in ms that a cached measurement is considered fresh
+
+    uint8_t getSignalCacheKey();
+    int8_t findSignalCache(uint8_t key, uint16_t channel);
+    void moveSignalCacheToFront(uint8_t idx);
+    void storeSignalCache(uint8_t key, uint16_t channel, int rssi, uint8_t cnr, uint8_t stereo);
+#endif
+
+#if AKC695X_USE_TRACE
+    // I2C trace (see setTraceBuffer and setTraceOutput)
+    akc_trace_record *traceBuffer = NULL;   //!< RAM ring buffer declared in your sketch
+    uint16_t traceSize = 0;                 //!< Number of elements of the traceBuffer
+    uint16_t traceHead = 0;                 //!< Next position to be written in the ring buffer
+    uint16_t traceCount = 0;                //!< Number of records stored in the ring buffer
+    Print *traceOutput = NULL;              //!< Stream (Serial) that receives the records
+    uint32_t traceLastTime = 0;             //!< micros() of the last record
+    uint8_t traceDepth = 0;                 //!< Nesting of the traced API calls (see AKC695XTraceScope)
+
+    friend class AKC695XTraceScope;
+    void trace(uint8_t op, uint8_t reg, uint8_t value);
+#else
+    inline void trace(uint8_t, uint8_t, uint8_t) {}
+#endif
+
+#if AKC695X_USE_LATENCY
+    // Tune latency histograms (see setLatencyHistogram)
+    akc_latency_histogram *latencyTable = NULL; //!< Array declared in your sketch
+    uint8_t latencySize = 0;                //!< Number of elements of the latencyTable
+    uint8_t latencyState = 0;               //!< 0 = idle; 1 = waiting for STC; 2 = waiting for tuned
+    uint8_t latencyKey;                     //!< Key of the current measurement (see akc_latency_histogram)
+    uint8_t latencyLastReg00 = 0;           //!< Last value written to REG00 (used to detect the trigger edge)
+    uint32_t latencyStart;                  //!< micros() value of the trigger or of STC = 1
+
+    void observeLatency(uint8_t op, uint8_t reg, uint8_t value);
+    akc_latency_histogram *findLatencyHistogram(uint8_t key, bool add);
+#else
+    inline void observeLatency(uint8_t, uint8_t, uint8_t) {}
+#endif
+
+#if AKC695X_USE_TUND
+    // TUND pin (see setTundPin)
+    static AKC695X *tundInstance;           //!< Instance notified by the interrupt service routine
+    int8_t tundPin = -1;                    //!< MCU pin connected to the TUND pin of the device (-1 = not used)
+    volatile uint8_t tundEdges = 0;         //!< Number of TUND pin changes (incremented by the interrupt service routine)
+    uint8_t tundSeenEdges = 0;              //!< Value of tundEdges at the last REG20 read of isTuningComplete
+    uint8_t tundUserEdges = 0;              //!< Value of tundEdges at the last call to isTundChanged
+    bool tundComplete = false;              //!< STC = 1 was read after the last tune or seek trigger
+    uint32_t tundLastPoll = 0;              //!< millis() value of the last REG20 read of isTuningComplete
+
+    static void tundInterrupt();
+    void tundTrigger(uint8_t reg, uint8_t value);
+#else
+    inline void tundTrigger(uint8_t, uint8_t) {}
+#endif
+
+#if AKC695X_USE_STATUS
+    // Shared status snapshot (see getStatus)
+    akc_status status = {};                 //!< Last status read
+    bool statusValid = false;               //!< false if a register was written after the last status read
+    uint8_t statusThreshold = AKC_STATUS_THRESHOLD; //!< RSSI and CNR change (in dB) notified to the subscribers
+    void (*statusSubscribers[AKC_STATUS_SUBSCRIBERS])(const akc_status *status) = {}; //!< Status change callbacks
+
+    bool isStatusChanged(const akc_status *previous);
+#endif
+
+#if AKC695X_USE_SCANNER
+    // Preset scanner (see startScanner)
+    const akc_preset *scanList = NULL;      //!< Presets declared in your sketch
+    uint8_t scanSize = 0;                   //!< Number of presets
+    uint8_t scanIndex = 0;                  //!< Preset being measured or held
+    uint8_t scanNext = 0;                   //!< Next preset (its registers are prepared in scanImage)
+    uint8_t scanState = AKC_SCAN_STOPPED;   //!< AKC_SCAN_STOPPED, AKC_SCAN_HOP, AKC_SCAN_LISTEN or AKC_SCAN_HOLD
+    bool scanSameBand = false;              //!< true if the next preset is in the current band (scanImage can be used)
+    uint8_t scanImage[4];                   //!< REG00 to REG03 of the next preset
+    int8_t scanMinRssi;                     //!< Squelch: minimum RSSI (dBuV)
+    uint8_t scanMinCnr;                     //!< Squelch: minimum CNR (dB)
+    uint16_t scanDwell;                     //!< Time (in ms) on each inactive preset
+    uint16_t scanHang;                      //!< Time (in ms) without signal before resuming the scan
+    uint32_t scanTime;                      //!< millis() value of the tune trigger or of the last active measure
+    uint32_t scanPoll;                      //!< millis() value of the last measure
+    void (*scanCallback)(uint8_t index, bool active) = NULL; //!< Called when the scanner stops on and leaves a preset
+
+    void prepareScannerHop(uint8_t index);
+    void scannerHop();
+    bool isScannerSignal();
+    void setScannerMute(bool on);
+#endif
+
+#if AKC695X_USE_DUAL_WATCH
+    // Priority channel dual-watch (see startDualWatch)
+    uint8_t watchState = AKC_WATCH_STOPPED; //!< AKC_WATCH_STOPPED, AKC_WATCH_MAIN or AKC_WATCH_PRIORITY
+    uint8_t watchMainImage[4];              //!< REG00 to REG03 of the main channel
+    uint8_t watchPriorityImage[4];          //!< REG00 to REG03 of the priority channel
+    uint16_t watchMain;                     //!< Main frequency
+    uint16_t watchPriority;                 //!< Priority frequency
+    uint16_t watchInterval;                 //!< Time (in ms) between two checks of the priority channel
+    int8_t watchMinRssi;                    //!< Minimum RSSI (dBuV) of an active priority channel
+    uint8_t watchMinCnr;                    //!< Minimum CNR (dB) of an active priority channel
+    uint32_t watchTime;                     //!< millis() value of the last check
+    uint32_t watchOffTime = 0;              //!< Time (in us) off the main channel in the last check
+    uint32_t watchMaxOffTime = 0;           //!< Longest time (in us) off the main channel
+    uint8_t watchStep;                      //!< Step of the current check (AKC_WATCH_STEP_IDLE when listening)
+    uint32_t watchReady;                    //!< micros() value when the device can receive the next transaction
+    uint32_t watchStart;                    //!< micros() value of the start of the current check
+
+    bool watchWrite(uint8_t reg, const uint8_t *values, uint8_t count);
+#endif
+
+#if AKC695X_USE_RAMP
+    // Volume ramps (see rampVolume)
+    uint8_t rampReg6;                       //!< REG06 without the volume (the ramp does not read REG06)
+    uint8_t rampFrom;                       //!< Volume at the beginning of the ramp
+    uint8_t rampTo;                         //!< Volume at the end of the ramp
+    uint8_t rampLevel;                      //!< Volume written to REG06
+    uint8_t rampCurve;                      //!< Curve of the ramp being run (AKC_RAMP_LINEAR to AKC_RAMP_SMOOTH)
+    uint8_t rampDefaultCurve = AKC_RAMP_SMOOTH; //!< Curve of the soft mute and unmute ramps
+    uint16_t rampTime;                      //!< Time (in ms) of the ramp being run
+    uint16_t rampDefaultTime = AKC_RAMP_TIME; //!< Time (in ms) of the soft mute and unmute ramps
+    bool rampRunning = false;               //!< true while a ramp is running
+    bool softMuted = false;                 //!< true after softMute (until softUnmute, rampVolume or setVolume)
+    uint32_t rampStart;                     //!< millis() value of the beginning of the ramp
+    uint32_t rampReady;                     //!< micros() value when the device can receive the next REG06 write
+    void (*rampCallback)() = NULL;          //!< Called at the end of the soft mute ramp
+
+    void startRamp(uint8_t volume, uint16_t time, uint8_t curve);
+#endif
+
+#if AKC695X_USE_ATS
+    // Automatic tuning storage (see startAts)
+    const uint8_t *atsBands = NULL;         //!< Band plan indexes declared in your sketch
+    uint8_t atsBandCount;                   //!< Number of bands
+    uint8_t atsBandIdx;                     //!< Band being swept
+    akc_preset *atsPresets;                 //!< Presets declared in your sketch (best station first)
+    uint8_t atsSize;                        //!< Number of presets (up to AKC_ATS_MAX_PRESETS)
+    uint8_t atsCount;                       //!< Stations found
+    uint8_t atsScore[AKC_ATS_MAX_PRESETS];  //!< Quality (RSSI + CNR) of each station found
+    uint8_t atsState = AKC_ATS_STOPPED;     //!< AKC_ATS_STOPPED to AKC_ATS_READ
+    int8_t atsMinRssi;                      //!< Minimum RSSI (dBuV) of a station
+    uint8_t atsMinCnr;                      //!< Minimum CNR (dB) of a station
+    uint16_t atsFrequency;                  //!< Frequency being measured
+    int8_t atsRssi[2];                      //!< RSSI of the two previous channels (peak detection)
+    uint8_t atsCnr;                         //!< CNR of the previous channel
+    uint16_t atsPeak;                       //!< Frequency of the last peak of the band (0 = none)
+    uint16_t atsBest;                       //!< Frequency of the best peak of the group of adjacent peaks
+    uint8_t atsPeakScore;                   //!< Quality of atsBest
+    uint32_t atsReady;                      //!< micros() value when the device can receive the next transaction
+    uint32_t atsTrigger;                    //!< micros() value of the tune trigger of the current channel
+    akc_preset atsRestore;                  //!< Mode, band and frequency in use before startAts
+    uint16_t atsRestoreMinimum;             //!< Band limits and step in use before startAts
+    uint16_t atsRestoreMaximum;
+    uint8_t atsRestoreStep;
+    uint8_t atsRestore3k;
 
-    // FM current band information
-    uint8_t fmCurrentBand = 0;
+    bool atsWrite(uint8_t reg, const uint8_t *values, uint8_t count);
+    void atsMeasure(int8_t rssi, uint8_t cnr);
+    void atsInsert(uint16_t frequency, uint8_t score);
+    void atsRemove(uint16_t frequency);
+    void atsNextBand();
+#endif
+
+#if AKC695X_USE_AFC
+    // Automatic frequency control (see startAfc)
+    uint16_t afcInterval = 0;               //!< Time (in ms) between two offset reads. 0 = stopped
+    uint16_t afcHold;                       //!< Minimum time (in ms) between two retunes
+    uint16_t afcBase = 0;                   //!< Channel of the current frequency (the correction is relative to it)
+    int8_t afcChannels = 0;                 //!< Correction in channels (tuned channel - afcBase)
+    uint8_t afcCount = 0;                   //!< Offset reads in the average since the last tune
+    int16_t afcAverage = 0;                 //!< Moving average of REG26 (REG26 units * 16)
+    uint32_t afcTime;                       //!< millis() value of the last offset read
+    uint32_t afcRetuneTime;                 //!< millis() value of the last retune
+#endif
+
+#if AKC695X_USE_TELEMETRY
+    // Telemetry recorder (see setTelemetry)
+    uint8_t *telemetryBuffer = NULL;        //!< Pages declared in your sketch (ring of telemetryPages pages)
+    uint8_t telemetryPageSize;              //!< Size (in bytes) of a page
+    uint8_t telemetryPages = 0;             //!< Number of pages of the buffer
+    uint8_t telemetryHead = 0;              //!< Page being filled
+    uint8_t telemetryStored = 0;            //!< Complete pages kept before the head
+    uint8_t telemetryUsed = 0;              //!< Bytes of records in the page being filled (0 = the next record is a keyframe)
+    uint16_t telemetrySeq = 0;              //!< Sequence number of the page being filled
+    uint32_t telemetryDelta = 0;            //!< Time between the last two samples (repeated deltas are not stored)
+    uint32_t telemetryInterval = 0;         //!< Time (in ms) between two samples. 0 = stopped
+    uint32_t telemetryStart;                //!< millis() value of startTelemetry
+    uint32_t telemetryLast;                 //!< millis() value of the last sample
+    akc_telemetry_sample telemetrySample = {}; //!< Last sample (reference of the next delta record)
+    Print *telemetryOutput = NULL;          //!< Stream that receives each complete page
+
+    uint8_t encodeTelemetry(const akc_telemetry_sample *sample, uint8_t *record, bool keyframe);
+    uint8_t closeTelemetryPage();
+    void nextTelemetryPage();
+#endif
+
+#if AKC695X_USE_BANDSCOPE
+    // Bandscope (see startBandscope)
+    uint8_t *bandscopeBuffer = NULL;        //!< Levels declared in your sketch. bit 7 = changed since the last frame; bits 0 to 6 = level in dBuV
+    uint8_t bandscopeBins = 0;              //!< Number of bins of the window
+    uint8_t bandscopeStep;                  //!< Frequency step between two bins
+    uint8_t bandscopeBin = 0;               //!< Bin being measured
+    uint8_t bandscopeState = 0;             //!< 0 = stopped; 1 = tune; 2 = trigger; 3 = status address; 4 = status read
+    uint8_t bandscopeSeq = 0;               //!< Sweep sequence number
+    uint8_t bandscopeMute;                  //!< REG00 mute bit before startBandscope
+    uint16_t bandscopeStart;                //!< Frequency of the bin 0
+    uint32_t bandscopeReady = 0;            //!< micros() value when the device can receive the next transaction
+    uint32_t bandscopeTrigger = 0;          //!< micros() value of the tune trigger of the current bin
+    Print *bandscopeOutput = NULL;          //!< Stream that receives a frame at the end of each sweep
+
+    bool bandscopeWrite(uint8_t reg, const uint8_t *values, uint8_t count);
+#endif
+
+#if AKC695X_USE_ASYNC
+    // Non-blocking transaction queue (see setTransactionQueue)
+    akc_transaction *queue = NULL;          //!< Ring buffer declared in your sketch
+    uint8_t queueSize = 0;                  //!< Number of elements of the queue
+    uint8_t queueHead = 0;                  //!< Next transaction to be processed
+    uint8_t queueCount = 0;                 //!< Number of transactions waiting
+    bool queueReadPending = false;          //!< true if the register address of a read was sent and the data was not read yet
+    uint8_t queueAttempts = 0;              //!< Failed attempts of the current transaction
+    uint32_t queueReady = 0;                //!< micros() value when the device can receive the next transaction
+    void (*queueCallback)(uint8_t reg, uint8_t value) = NULL; //!< Called when a queued read completes
+
+    bool enqueue(uint8_t op_reg, uint8_t value);
+#endif
 
 public:
     // Low level functions
@@ -471,10 +1396,14 @@ public:
 
     void setup(int reset_pin);
     void setup(int reset_pin, uint8_t crystal_type);
+    void fastSetup(int reset_pin, uint8_t crystal_type, uint8_t fm_en, uint8_t band, uint16_t minimum_freq, uint16_t maximum_freq, uint16_t default_frequency, uint8_t default_step, uint8_t volume, akc_boot_timing *timing = NULL);
 
     void powerOn(uint8_t fm_en, uint8_t tune, uint8_t mute, uint8_t seek, uint8_t seekup);
-    void setRegister(uint8_t reg, uint8_t parameter);
+    bool setRegister(uint8_t reg, uint8_t parameter);
     uint8_t getRegister(uint8_t reg);
+    bool setRegisters(uint8_t reg, const uint8_t *values, uint8_t count);
+    bool getRegisters(uint8_t reg, uint8_t *values, uint8_t count);
+    inline uint8_t getBusResult() { return this->busResult; };
     void setCrystalType(uint8_t crystal);
 
     bool isTuned();
@@ -496,12 +1425,16 @@ public:
     void setFM(uint8_t akc695x_fm_band, uint16_t minimum_freq, uint16_t maximum_freq, uint16_t default_frequency, uint8_t default_step);
     void setAM(uint8_t akc695x_am_band, uint16_t minimum_freq, uint16_t maximum_freq, uint16_t default_frequency, uint8_t default_step);
 
+#if AKC695X_USE_CUSTOM_BAND
     void setCustomBand(uint16_t minimum_frequency, uint16_t maximum_frequency);
+#endif
 
     void setStep(uint8_t step);
 
+#if AKC695X_USE_SEEK
     void setFmSeekStep(uint8_t value);
     void seekStation(uint8_t up_down, void (*showFunc)() = NULL);
+#endif
 
     void setFrequency(uint16_t frequency);
     uint16_t getFrequency();
@@ -518,9 +1451,13 @@ public:
     inline int getVolume() { return this->volume; };
 
     int getRSSI();
+    uint16_t getSupplyVoltageMillivolts();
+#if AKC695X_USE_FLOAT
     float getSupplyVoltage();
+#endif
 
     inline uint8_t getCurrentMode() { return this->currentMode; };
+    inline uint8_t getCurrentBand() { return this->currentBand; };
 
     /**
      * @ingroup GA03A
@@ -531,7 +1468,280 @@ public:
 
     void commitTune();
 
+#if AKC695X_USE_BUS_RECOVERY
+    void setBusRetries(uint8_t retries);
+    inline const akc_bus_errors *getBusErrors() { return &this->busErrors; };
+    void clearBusErrors();
+    void recoverBus();
+    uint32_t getBusMaxTime();
+#endif
+
+#if AKC695X_USE_TRANSACTION
+    void beginTransaction();
+    void commitTransaction();
+    inline bool isTransactionOpen() { return this->transactionOpen; };
+#endif
+
+#if AKC695X_USE_STANDBY
+    void standby();
+    void resume();
+    inline bool isStandby() { return this->standbyMode; };
+#endif
+
+#if AKC695X_USE_PROFILES
+    void saveProfile(akc_profile *profile);
+    void applyProfile(const akc_profile *profile);
+    void setBandStack(akc_profile *slots, uint8_t size);
+    bool recallBand(uint8_t idx);
+    inline int8_t getBandStackIndex() { return this->bandStackCurrent; };
+#endif
+
+#if AKC695X_USE_FORMAT
     void convertToChar(uint16_t value, char *strValue, uint8_t len, uint8_t dot, uint8_t separator, bool remove_leading_zeros = true);
+#endif
+
+#if AKC695X_USE_SIGNAL_CACHE
+    void setSignalCache(akc_signal_cache *buffer, uint8_t size, uint16_t max_age = 3000);
+    void clearSignalCache();
+    uint8_t getCachedSignal(akc_signal_cache *signal);
+    uint8_t getCachedSignal(uint16_t frequency, akc_signal_cache *signal);
+    void refreshSignalCache();
+#endif
+
+#if AKC695X_USE_ASYNC
+    void setTransactionQueue(akc_transaction *buffer, uint8_t size, void (*callback)(uint8_t reg, uint8_t value) = NULL);
+    bool queueRegister(uint8_t reg, uint8_t value);
+    bool queueRead(uint8_t reg);
+    bool queueFrequency(uint16_t frequency);
+    uint8_t processQueue();
+    void flushQueue();
+    inline bool isQueueIdle() { return this->queueCount == 0; };
+    inline uint8_t getQueueCount() { return this->queueCount; };
+#endif
+
+#if AKC695X_USE_STATUS
+    const akc_status *getStatus(uint16_t max_age = 0);
+    int8_t subscribeStatus(void (*callback)(const akc_status *status));
+    void unsubscribeStatus(int8_t id);
+    inline void setStatusThreshold(uint8_t db) { this->statusThreshold = db; };
+#endif
+
+#if AKC695X_USE_SCANNER
+    void startScanner(const akc_preset *list, uint8_t size, uint16_t dwell, int8_t min_rssi, uint8_t min_cnr, uint16_t hang = 2000, void (*callback)(uint8_t index, bool active) = NULL);
+    void stopScanner();
+    uint8_t processScanner();
+    inline uint8_t getScannerIndex() { return this->scanIndex; };
+    inline uint8_t getScannerState() { return this->scanState; };
+#endif
+
+#if AKC695X_USE_DUAL_WATCH
+    void startDualWatch(uint16_t priority_frequency, uint16_t interval, int8_t min_rssi, uint8_t min_cnr);
+    void stopDualWatch();
+    uint8_t processDualWatch();
+    inline uint32_t getDualWatchOffTime() { return this->watchOffTime; };
+    inline uint32_t getDualWatchMaxOffTime() { return this->watchMaxOffTime; };
+#endif
+
+#if AKC695X_USE_RAMP
+    void setRampTime(uint16_t time, uint8_t curve = AKC_RAMP_SMOOTH);
+    void rampVolume(uint8_t volume, uint16_t time, uint8_t curve = AKC_RAMP_SMOOTH);
+    void softMute(void (*callback)() = NULL);
+    void softUnmute();
+    bool processRamp();
+    inline bool isRampRunning() { return this->rampRunning; };
+    inline bool isSoftMuted() { return this->softMuted; };
+#endif
+
+#if AKC695X_USE_ATS
+    bool startAts(const uint8_t *bands, uint8_t band_count, akc_preset *presets, uint8_t size, int8_t min_rssi, uint8_t min_cnr);
+    void stopAts();
+    bool processAts();
+    inline bool isAtsRunning() { return this->atsState != AKC_ATS_STOPPED; };
+    inline uint8_t getAtsCount() { return this->atsCount; };
+    inline uint16_t getAtsFrequency() { return this->atsFrequency; };
+    inline uint8_t getAtsScore(uint8_t idx) { return this->atsScore[idx]; };
+#endif
+
+#if AKC695X_USE_AFC
+    void startAfc(uint16_t interval = AKC_AFC_INTERVAL, uint16_t hold = AKC_AFC_HOLD_TIME);
+    void stopAfc();
+    bool processAfc();
+    int32_t getAfcOffset();
+    int32_t getAfcPpm();
+    inline int8_t getAfcChannels() { return this->afcChannels; };
+    inline bool isAfcRunning() { return this->afcInterval != 0; };
+#endif
+
+#if AKC695X_USE_TELEMETRY
+    bool setTelemetry(uint8_t *buffer, uint16_t size, uint8_t page_size = AKC_TELEMETRY_PAGE_SIZE, Print *output = NULL);
+    void startTelemetry(uint32_t interval);
+    void stopTelemetry();
+    bool processTelemetry();
+    bool recordTelemetry();
+    void flushTelemetry();
+    void dumpTelemetry(Print *output);
+    inline bool isTelemetryRunning() { return this->telemetryInterval != 0; };
+    inline const akc_telemetry_sample *getTelemetrySample() { return &this->telemetrySample; };
+#endif
+
+#if AKC695X_USE_BANDSCOPE
+    bool startBandscope(uint8_t *buffer, uint8_t bins, uint8_t step, Print *output = NULL);
+    void stopBandscope();
+    bool processBandscope();
+    void sendBandscopeFrame(Print *output);
+    inline bool isBandscopeRunning() { return this->bandscopeState != 0; };
+    inline uint8_t getBandscopeBins() { return this->bandscopeBins; };
+    inline uint16_t getBandscopeFrequency(uint8_t bin) { return this->bandscopeStart + bin * this->bandscopeStep; };
+    inline uint8_t getBandscopeLevel(uint8_t bin) { return this->bandscopeBuffer[bin] & 0x7F; };
+#endif
+
+#if AKC695X_USE_TUND
+    void setTundPin(int8_t pin);
+    bool isTundChanged();
+#endif
+
+#if AKC695X_USE_LATENCY
+    void setLatencyHistogram(akc_latency_histogram *table, uint8_t size);
+    void clearLatencyHistogram();
+    akc_latency_histogram *getLatencyHistogram(uint8_t mode, uint8_t band, bool seek = false);
+    uint16_t getLatencyPercentile(const akc_latency_histogram *histogram, uint8_t phase, uint8_t percent);
+    void dumpLatencyHistogram(Print *output);
+#endif
+
+#if AKC695X_USE_BAND_PLAN
+    uint8_t getBandPlanSize();
+    void getBandPlan(uint8_t idx, akc_band_plan *band);
+    int8_t getBandPlanIndex(uint8_t mode, uint8_t band);
+    int8_t findBandPlan(uint8_t mode, uint16_t frequency);
+    void useBandPlan(uint8_t idx, uint16_t frequency);
+#endif
+
+#if AKC695X_USE_TRACE
+    void setTraceBuffer(akc_trace_record *buffer, uint16_t size);
+    void setTraceOutput(Print *output);
+    void traceMark(uint8_t api_id);
+    void dumpTrace(Print *output);
+    inline uint16_t getTraceCount() { return this->traceCount; };
+#else
+    inline void traceMark(uint8_t) {}
+#endif
+};
+
+/**
+ * @ingroup GA07
+ * @brief Trace marker of a library API call
+ * @details Declared at the beginning of the traced methods. Only the outermost API call emits a marker, so the bus time of
+ * @details the nested calls (setFM calls setFrequency, refreshSignalCache calls getRSSI) is charged to the method called by the sketch.
+ */
+class AKC695XTraceScope
+{
+public:
+#if AKC695X_USE_TRACE
+    AKC695XTraceScope(AKC695X *radio, uint8_t api_id) : radio(radio)
+    {
+        if (radio->traceDepth++ == 0)
+            radio->traceMark(api_id);
+    }
+    ~AKC695XTraceScope() { this->radio->traceDepth--; }
+
+private:
+    AKC695X *radio;
+#else
+    AKC695XTraceScope(AKC695X *, uint8_t) {}
+#endif
+};
+
+#if AKC695X_USE_SCHEDULER
+/**
+ * @ingroup GA09
+ * @brief Cooperative task scheduler
+ * @details Runs periodic and one-shot jobs (RSSI polling, display refresh, EEPROM saving and other radio housekeeping)
+ * @details from the loop function. It does not allocate memory: the task array is declared in your sketch.
+ * @details Each call to run executes at most one task. So, jobs that access the I2C bus are spread over loop iterations and
+ * @details the loop keeps processing the encoder with low latency.
+ */
+class AKC695XScheduler
+{
+protected:
+    akc_task *tasks = NULL; //!< Array declared in your sketch
+    uint8_t size = 0;       //!< Number of elements of the tasks array
+
+public:
+    void setup(akc_task *buffer, uint8_t size);
+    int8_t addTask(void (*callback)(), uint16_t period, uint16_t first_delay = 0, uint8_t priority = 0, uint16_t deadline = 0xFFFF);
+    void removeTask(int8_t id);
+    void scheduleTask(int8_t id, uint16_t delay_time);
+    int8_t run();
+    uint16_t getAverageJitter(int8_t id);
+    void resetStatistics();
+    inline akc_task *getTask(int8_t id) { return &this->tasks[id]; };
+};
+#endif
+
+#if AKC695X_USE_LINK
+/**
+ * @ingroup GA14
+ * @brief Binary serial control protocol
+ * @details Receives request frames with batched commands from a stream (Serial), runs them on an AKC695X instance and
+ * @details replies with a compact status frame (see the GA14 section).
+ */
+class AKC695XLink
+{
+protected:
+    AKC695X *radio = NULL;                          //!< Receiver controlled by the link
+    Stream *port = NULL;                            //!< Stream of the requests and replies
+    uint8_t frame[AKC_LINK_MAX_PAYLOAD + 3];        //!< Request being received: sequence, length, payload and CRC
+    uint8_t received = 0;                           //!< Number of bytes of the frame received (0 = waiting for the sync byte)
+    uint32_t lastByteTime = 0;                      //!< millis() value of the last byte received
+    uint8_t lastSeq = 0;                            //!< Sequence number of the last request executed
+    uint8_t lastResult = 0;                         //!< Result of the last request executed
+    bool lastValid = false;                         //!< true if lastSeq and lastResult are valid
+    uint16_t frameCount = 0;                        //!< Number of requests executed
+    uint16_t errorCount = 0;                        //!< Number of requests rejected
+
+    uint8_t execute(const uint8_t *payload, uint8_t length);
+    void reply(uint8_t seq, uint8_t result);
+
+public:
+    void setup(AKC695X *radio, Stream *port);
+    bool process();
+    static uint8_t crc8(const uint8_t *data, uint8_t length, uint8_t crc = 0);
+    inline uint16_t getFrameCount() { return this->frameCount; };
+    inline uint16_t getErrorCount() { return this->errorCount; };
+};
+#endif
+
+#if AKC695X_USE_BUTTON
+/**
+ * @ingroup GA22
+ * @brief Push button gestures
+ * @details Debounces a push button with timestamps and recognizes click, double click and long press without blocking
+ * @details (see the GA22 section). Use one instance per button.
+ */
+class AKC695XButton
+{
+protected:
+    int8_t pin = -1;                                //!< Arduino pin of the button (-1 = not set up)
+    bool activeLow = true;                          //!< true = the pin is LOW when the button is pressed
+    bool level = false;                             //!< Last level read (true = pressed), not debounced yet
+    bool pressed = false;                           //!< Debounced state
+    bool longSent = false;                          //!< true if the current press was reported as a long press
+    uint8_t clicks = 0;                             //!< Clicks waiting for the double click time
+    uint16_t debounceTime = AKC_BUTTON_DEBOUNCE_TIME; //!< Time (in ms) the level must be stable
+    uint16_t doubleTime = AKC_BUTTON_DOUBLE_TIME;   //!< Maximum time (in ms) between two clicks of a double click. 0 = no double click
+    uint16_t longTime = AKC_BUTTON_LONG_TIME;       //!< Time (in ms) of a long press
+    uint32_t levelTime = 0;                         //!< millis() value of the last level change
+    uint32_t pressTime = 0;                         //!< millis() value of the debounced press
+    uint32_t releaseTime = 0;                       //!< millis() value of the debounced release
+    void (*callbacks[3])() = {};                    //!< Functions called by process (click, double click and long press)
+
+public:
+    void setup(uint8_t pin, bool active_low = true);
+    void setTimes(uint16_t debounce, uint16_t double_click, uint16_t long_press);
+    void attach(uint8_t gesture, void (*callback)());
+    uint8_t process();
+    inline bool isPressed() { return this->pressed; };
 };
+#endif
 
 #endif // _AKC6955_H
@@ -0,0 +1,162 @@
+/**
+ * @file AKC695X_config.h
+ * @brief AKC695X Arduino Library compile-time feature selection
+ *
+ * @details Each AKC695X_USE_* macro below includes (1) or strips (0) a subsystem of the library.
+ * @details Stripping a subsystem removes its methods and its member variables, saving flash and RAM.
+ * @details You can edit this file or define the macros as build flags. For example, with arduino-cli:
+ * @code
+ * arduino-cli compile -b arduino:avr:pro --build-property "compiler.cpp.extra_flags=-DAKC695X_TINY -DAKC695X_USE_SEEK=1" mysketch
+ * @endcode
+ *
+ * @details AKC695X_TINY disables all optional subsystems at once. You can still enable some of them individually.
+ * @details The tiny build keeps the basic receiver operation: setup, setFM, setAM, setFrequency, volume and status methods.
+ * @details See extras/footprint/footprint.sh to measure the flash and RAM used by each configuration.
+ *
+ * | Macro                      | Subsystem                                                   |
+ * | -------------------------- | ----------------------------------------------------------- |
+ * | AKC695X_USE_SEEK           | seekStation and setFmSeekStep                               |
+ * | AKC695X_USE_CUSTOM_BAND    | setCustomBand (FM band > 7 and AM band > 17)                |
+ * | AKC695X_USE_FORMAT         | convertToChar                                               |
+ * | AKC695X_USE_FLOAT          | getSupplyVoltage (float). Use getSupplyVoltageMillivolts instead |
+ * | AKC695X_USE_STANDBY        | standby and resume                                          |
+ * | AKC695X_USE_PROFILES       | saveProfile and applyProfile                                |
+ * | AKC695X_USE_SIGNAL_CACHE   | Signal quality cache                                        |
+ * | AKC695X_USE_TRACE          | I2C trace                                                   |
+ * | AKC695X_USE_BAND_PLAN      | Native band plan stored in flash (PROGMEM)                  |
+ * | AKC695X_USE_SCHEDULER      | AKC695XScheduler (cooperative task scheduler)               |
+ * | AKC695X_USE_ASYNC          | Non-blocking I2C transaction queue                          |
+ * | AKC695X_USE_TRANSACTION    | beginTransaction and commitTransaction (deferred writes)    |
+ * | AKC695X_USE_LATENCY        | Tune and seek latency histograms                            |
+ * | AKC695X_USE_TUND           | TUND pin interrupt instead of REG20 polling (setTundPin)    |
+ * | AKC695X_USE_BANDSCOPE      | Non-blocking bandscope with RLE frame streaming             |
+ * | AKC695X_USE_LINK           | AKC695XLink binary serial control protocol                  |
+ * | AKC695X_USE_STATUS         | Shared status snapshot with change notifications            |
+ * | AKC695X_USE_SCANNER        | Preset memory scanner (needs AKC695X_USE_BAND_PLAN)         |
+ * | AKC695X_USE_DUAL_WATCH     | Priority channel dual-watch                                 |
+ * | AKC695X_USE_BUS_RECOVERY   | I2C retries, bus recovery and error counters                |
+ * | AKC695X_USE_TELEMETRY      | Delta-encoded reception telemetry recorder                  |
+ * | AKC695X_USE_AFC            | Automatic frequency control from the REG26 offset           |
+ * | AKC695X_USE_ATS            | Automatic tuning storage (needs AKC695X_USE_BAND_PLAN)      |
+ * | AKC695X_USE_RAMP           | Non-blocking volume ramps and soft mute                     |
+ * | AKC695X_USE_BUTTON         | AKC695XButton push button gestures (click, double, long)    |
+ */
+
+#ifndef _AKC695X_CONFIG_H
+#define _AKC695X_CONFIG_H
+
+#ifdef AKC695X_TINY
+#define AKC695X_FEATURE_DEFAULT 0
+#else
+#define AKC695X_FEATURE_DEFAULT 1
+#endif
+
+#ifndef AKC695X_USE_SEEK
+#define AKC695X_USE_SEEK AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_CUSTOM_BAND
+#define AKC695X_USE_CUSTOM_BAND AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_FORMAT
+#define AKC695X_USE_FORMAT AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_FLOAT
+#define AKC695X_USE_FLOAT AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_STANDBY
+#define AKC695X_USE_STANDBY AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_PROFILES
+#define AKC695X_USE_PROFILES AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_SIGNAL_CACHE
+#define AKC695X_USE_SIGNAL_CACHE AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_TRACE
+#define AKC695X_USE_TRACE AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_BAND_PLAN
+#define AKC695X_USE_BAND_PLAN AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_SCHEDULER
+#define AKC695X_USE_SCHEDULER AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_ASYNC
+#define AKC695X_USE_ASYNC AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_TRANSACTION
+#define AKC695X_USE_TRANSACTION AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_LATENCY
+#define AKC695X_USE_LATENCY AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_TUND
+#define AKC695X_USE_TUND AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_BANDSCOPE
+#define AKC695X_USE_BANDSCOPE AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_LINK
+#define AKC695X_USE_LINK AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_STATUS
+#define AKC695X_USE_STATUS AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_SCANNER
+#define AKC695X_USE_SCANNER AKC695X_USE_BAND_PLAN
+#endif
+
+#ifndef AKC695X_USE_DUAL_WATCH
+#define AKC695X_USE_DUAL_WATCH AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_BUS_RECOVERY
+#define AKC695X_USE_BUS_RECOVERY AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_TELEMETRY
+#define AKC695X_USE_TELEMETRY AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_AFC
+#define AKC695X_USE_AFC AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_ATS
+#define AKC695X_USE_ATS AKC695X_USE_BAND_PLAN
+#endif
+
+#ifndef AKC695X_USE_RAMP
+#define AKC695X_USE_RAMP AKC695X_FEATURE_DEFAULT
+#endif
+
+#ifndef AKC695X_USE_BUTTON
+#define AKC695X_USE_BUTTON AKC695X_FEATURE_DEFAULT
+#endif
+
+#if AKC695X_USE_SCANNER && !AKC695X_USE_BAND_PLAN
+#error "AKC695X_USE_SCANNER needs AKC695X_USE_BAND_PLAN"
+#endif
+
+#if AKC695X_USE_ATS && !AKC695X_USE_BAND_PLAN
+#error "AKC695X_USE_ATS needs AKC695X_USE_BAND_PLAN"
+#endif
+
+#endif // _AKC695X_CONFIG_H
@@ -10,6 +10,8 @@ uint16_t currentAM = 810;
 
 uint16_t currentFrequency;
 
+akc_boot_timing bootTime;
+
 void setup() {
 
   Serial.begin(9600);
@@ -18,18 +20,30 @@ void setup() {
   showHelp();
   // You can select the RESET pin and Crystal type you are using in your circuit.
   // Set RESET_PIN to -1 if you are using the Arduino RST pin; Select CRYSTAL_32KHz or CRYSTAL_12MHZ
+  // The lines below do the same as fastSetup, but they take longer.
   // radio.setup(RESET_PIN, CRYSTAL_12MHZ);
-  radio.setup(RESET_PIN, CRYSTAL_12MHZ);
-  // radio.setup(RESET_PIN, CRYSTAL_32KHz);
-  delay(500);
+  // radio.setFM(0, 870, 1080, currentFrequency, 1);
+  // radio.setAudio(); // Sets the audio output behaviour (default configuration).
   currentFrequency = currentFM = 1039;
-  radio.setFM(0, 870, 1080, currentFrequency, 1);
-  
-  radio.setAudio(); // Sets the audio output behaviour (default configuration). 
+  radio.fastSetup(RESET_PIN, CRYSTAL_12MHZ, AKC_FM, 0, 870, 1080, currentFrequency, 1, 40, &bootTime);
 
+  showBootTime();
   showStatus();
 }
 
+// Shows how long the receiver took to start (in microseconds)
+void showBootTime()
+{
+  Serial.print("Boot time (us) - Reset: ");
+  Serial.print(bootTime.reset);
+  Serial.print(" - Config: ");
+  Serial.print(bootTime.config);
+  Serial.print(" - Tune: ");
+  Serial.print(bootTime.tune);
+  Serial.print(" - Total: ");
+  Serial.println(bootTime.total);
+}
+
 
 void showHelp()
 {
@@ -0,0 +1,29 @@
+/*
+ * Controls the receiver from a PC using the binary serial control protocol (AKC695XLink).
+ * The Serial port is used only by the protocol. Do not print anything else on it.
+ *
+ * On the PC (Linux), compile and use extras/tools/akc695x_remote.cpp. Example:
+ *   akc695x_remote /dev/ttyUSB0 fm 0 870 1080 1039 1 vol 40
+ *
+ * To share the receiver among several programs, run extras/tools/akc695x_daemon.cpp instead. The programs talk to the
+ * daemon through a Unix domain socket (see the comments of that file).
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <AKC695X.h>
+
+#define RESET_PIN 12   // set it to -1 if you want to use the RST pin of your MCU.
+
+AKC695X radio;
+AKC695XLink link;
+
+void setup() {
+  Serial.begin(115200);
+  radio.fastSetup(RESET_PIN, CRYSTAL_12MHZ, AKC_FM, 0, 870, 1080, 1039, 1, 40);
+  link.setup(&radio, &Serial);
+}
+
+void loop() {
+  link.process();
+}
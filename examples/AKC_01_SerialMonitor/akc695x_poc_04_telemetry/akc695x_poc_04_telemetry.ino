@@ -0,0 +1,98 @@
+/*
+ * Long-term reception monitor. Records one sample (frequency, RSSI, CNR, stereo, tuned and supply voltage) every 10s
+ * with the telemetry recorder of the library. The complete pages are written to the internal EEPROM (a ring of pages).
+ * Send 'd' to dump all pages to the Serial port and 'c' to clear the EEPROM.
+ *
+ * On the PC (Linux), capture the dump and convert it to CSV with extras/tools/akc695x_telemetry.cpp:
+ *   stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > capture.bin    (send 'd' from another terminal)
+ *   akc695x_telemetry capture.bin > samples.csv
+ *
+ * To write the pages directly to the PC instead of the EEPROM, use &Serial as output of setTelemetry.
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <AKC695X.h>
+#include <EEPROM.h>
+
+#define RESET_PIN 12   // set it to -1 if you want to use the RST pin of your MCU.
+#define PAGE_SIZE 32   // The ATmega328 EEPROM (1KB) holds 32 pages of 32 bytes
+
+// Writes each page received from the recorder to the next EEPROM slot. The oldest page is overwritten.
+class EepromPages : public Print
+{
+public:
+  void begin()
+  {
+    // Continues on the first free slot (send 'c' to clear the EEPROM before a new recording)
+    for (slot = 0; slot < slots() && EEPROM.read(slot * PAGE_SIZE) == AKC_TELEMETRY_SYNC; slot++)
+      ;
+    slot %= slots();
+    offset = 0;
+  }
+
+  size_t write(uint8_t c)
+  {
+    if (offset < PAGE_SIZE)
+      EEPROM.update(slot * PAGE_SIZE + offset++, c);
+    return 1;
+  }
+
+  size_t write(const uint8_t *buffer, size_t size)
+  {
+    offset = 0;
+    for (size_t i = 0; i < size; i++)
+      write(buffer[i]);
+    slot = (slot + 1) % slots();
+    return size;
+  }
+
+  void dump(Print *output)
+  {
+    for (uint16_t i = 0; i < slots(); i++)
+      for (uint16_t j = 0; j < PAGE_SIZE; j++)
+        output->write(EEPROM.read(((slot + i) % slots()) * PAGE_SIZE + j));
+  }
+
+  void clear()
+  {
+    for (uint16_t i = 0; i < EEPROM.length(); i++)
+      EEPROM.update(i, 0xFF);
+    slot = 0;
+  }
+
+private:
+  uint16_t slot;
+  uint8_t offset;
+
+  uint16_t slots() { return EEPROM.length() / PAGE_SIZE; }
+};
+
+AKC695X radio;
+EepromPages eeprom;
+uint8_t pages[2 * PAGE_SIZE];
+
+void setup() {
+  Serial.begin(115200);
+  radio.fastSetup(RESET_PIN, CRYSTAL_12MHZ, AKC_FM, 0, 870, 1080, 1039, 1, 40);
+
+  eeprom.begin();
+  radio.setTelemetry(pages, sizeof(pages), PAGE_SIZE, &eeprom);
+  radio.startTelemetry(10000);
+}
+
+void loop() {
+  radio.processTelemetry();
+
+  if (Serial.available() > 0)
+  {
+    char key = Serial.read();
+    if (key == 'd')
+    {
+      radio.flushTelemetry(); // Writes the page being filled to the EEPROM
+      eeprom.dump(&Serial);
+    }
+    else if (key == 'c')
+      eeprom.clear();
+  }
+}
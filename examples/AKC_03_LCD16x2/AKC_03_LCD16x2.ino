@@ -55,10 +55,8 @@
 // Buttons controllers
 #define ENCODER_PUSH_BUTTON 14 // Pin A0/14
 
-#define MIN_ELAPSED_TIME 300
 #define MIN_ELAPSED_RSSI_TIME 500
 #define ELAPSED_COMMAND 2000 // time to turn off the last command controlled by encoder. Time to goes back to the FVO control
-#define ELAPSED_CLICK 1500   // time to check the double click commands
 #define DEFAULT_VOLUME 36    // change it for your favorite sound volume
 
 #define FM 0
@@ -78,8 +76,6 @@ long storeTime = millis();
 
 bool itIsTimeToSave = false;
 
-uint8_t countClick = 0;
-
 uint8_t seekDirection = 1;
 
 bool cmdBand = false;
@@ -92,7 +88,6 @@ bool cmdMenu = false;
 long elapsedRSSI = millis();
 long elapsedButton = millis();
 long elapsedCommand = millis();
-long elapsedClick = millis();
 volatile int encoderCount = 0;
 uint16_t currentFrequency;
 uint16_t previousFrequency = 0;
@@ -134,6 +129,8 @@ akc_band band[] = {
 const int lastBand = (sizeof band / sizeof(akc_band)) - 1;
 int bandIdx = 0; // FM
 
+akc_profile bandStack[lastBand + 1]; // Last configuration of each band (see useBand)
+
 typedef struct
 {
   uint8_t idx;      
@@ -155,11 +152,14 @@ Rotary encoder = Rotary(ENCODER_PIN_A, ENCODER_PIN_B);
 
 LiquidCrystal lcd(LCD_RS, LCD_E, LCD_D4, LCD_D5, LCD_D6, LCD_D7);
 AKC695X rx;
+AKC695XButton button;  // Encoder push button: click, double click (menu)
 
 void setup()
 {
   // Encoder pins
-  pinMode(ENCODER_PUSH_BUTTON, INPUT_PULLUP);
+  button.setup(ENCODER_PUSH_BUTTON);
+  button.attach(AKC_BUTTON_CLICK, onClick);
+  button.attach(AKC_BUTTON_DOUBLE_CLICK, onDoubleClick);
   pinMode(ENCODER_PIN_A, INPUT_PULLUP);
   pinMode(ENCODER_PIN_B, INPUT_PULLUP);
   lcd.begin(16, 2);
@@ -191,6 +191,7 @@ void setup()
 
   // rx.setup(RESET_PIN,CRYSTAL_12MHZ); 
   rx.setup(RESET_PIN, CRYSTAL_32KHz);    
+  rx.setBandStack(bandStack, lastBand + 1);
   delay(500);
 
   // rx.setFM(band[bandIdx].band, band[bandIdx].minimum_frequency, band[bandIdx].maximum_frequency,band[bandIdx].currentFreq, band[bandIdx].step);
@@ -285,7 +286,6 @@ void disableCommands()
   cmdBandwidth = false;
   cmdStep = false;
   cmdMenu = false;
-  countClick = 0;
 
   showCommandStatus((char *) "VFO ");
 }
@@ -459,7 +459,6 @@ void setBand(int8_t up_down)
   else
     bandIdx = (bandIdx > 0) ? (bandIdx - 1) : lastBand;
   useBand();
-  delay(MIN_ELAPSED_TIME); // waits a little more for releasing the button.
 }
 
 /**
@@ -467,19 +466,21 @@ void setBand(int8_t up_down)
  */
 void useBand()
 {
-
-  if (band[bandIdx].mode == AKC_FM)
-  {
-    rx.setFM(band[bandIdx].band, band[bandIdx].minimum_frequency, band[bandIdx].maximum_frequency, band[bandIdx].currentFreq, band[bandIdx].step);
-    // rx.setFmSeekStep(0); // 0 = 25kHz; 1 = 50kHz; 2 = 100kHz; 3= 200kHz (default 2).
-  }
-  else
+  // The band stack restores the last configuration of the band writing just what is different.
+  // The first time a band is used, it is configured by setFM or setAM.
+  if (!rx.recallBand(bandIdx))
   {
-    rx.setAM(band[bandIdx].band, band[bandIdx].minimum_frequency, band[bandIdx].maximum_frequency, band[bandIdx].currentFreq, band[bandIdx].step);
+    if (band[bandIdx].mode == AKC_FM)
+    {
+      rx.setFM(band[bandIdx].band, band[bandIdx].minimum_frequency, band[bandIdx].maximum_frequency, band[bandIdx].currentFreq, band[bandIdx].step);
+      // rx.setFmSeekStep(0); // 0 = 25kHz; 1 = 50kHz; 2 = 100kHz; 3= 200kHz (default 2).
+    }
+    else
+    {
+      rx.setAM(band[bandIdx].band, band[bandIdx].minimum_frequency, band[bandIdx].maximum_frequency, band[bandIdx].currentFreq, band[bandIdx].step);
+    }
   }
-  delay(500);
-  currentFrequency = band[bandIdx].currentFreq;
-  rx.setFrequency(currentFrequency);
+  currentFrequency = rx.getFrequency();
   showStatus();
   showCommandStatus((char *) "Band");
 }
@@ -500,7 +501,6 @@ void doBandwidth(int8_t v)
    rx.setFmBandwidth(bandwidthFM[bwIdxFM].idx);
    showBandwidth();
   }
-  delay(MIN_ELAPSED_TIME); // waits a little more for releasing the button.
 }
 
 /**
@@ -537,7 +537,6 @@ void doStep(int8_t v)
       band[bandIdx].step = step; 
     }
     showStep();
-    delay(MIN_ELAPSED_TIME); // waits a little more for releasing the button.
     elapsedCommand = millis();
 }
 
@@ -552,7 +551,6 @@ void doVolume( int8_t v ) {
     rx.setVolumeDown();
 
   showVolume();
-  delay(MIN_ELAPSED_TIME); // waits a little more for releasing the button.
 }
 
 
@@ -579,7 +577,6 @@ void doMenu( int8_t v) {
     menuIdx = lastMenu;
 
   showMenu();
-  delay(MIN_ELAPSED_TIME); // waits a little more for releasing the button.
   elapsedCommand = millis();
 }
 
@@ -631,6 +628,41 @@ void doCurrentMenuCmd() {
 
 
 
+/**
+ * Encoder push button: single click
+ */
+void onClick()
+{
+  if (cmdMenu)
+  {
+    currentMenuCmd = menuIdx;
+    doCurrentMenuCmd();
+  }
+  else if (isMenuMode())
+  {
+    disableCommands();
+    showStatus();
+    showCommandStatus((char *)"VFO ");
+  }
+  else
+  { // If just one click, you can select the band by rotating the encoder
+    cmdBand = !cmdBand;
+    showCommandStatus((char *)"Band");
+  }
+  elapsedCommand = millis();
+}
+
+/**
+ * Encoder push button: double click goes to MENU
+ */
+void onDoubleClick()
+{
+  cmdMenu = !cmdMenu;
+  if (cmdMenu)
+    showMenu();
+  elapsedCommand = millis();
+}
+
 /**
  * Main loop
  */
@@ -666,40 +698,9 @@ void loop()
     encoderCount = 0;
     resetEepromDelay();
   }
-  else
-  {
-    if (digitalRead(ENCODER_PUSH_BUTTON) == LOW)
-    {
-      countClick++;
-      if (cmdMenu)
-      {
-        currentMenuCmd = menuIdx;
-        doCurrentMenuCmd();
-      }
-      else if (countClick == 1)
-      { // If just one click, you can select the band by rotating the encoder
-        if (isMenuMode())
-        {
-          disableCommands();
-          showStatus();
-          showCommandStatus((char *)"VFO ");
-        }
-        else
-        {
-          cmdBand = !cmdBand;
-          showCommandStatus((char *)"Band");
-        }
-      }
-      else
-      { // GO to MENU if more than one click in less than 1/2 seconds.
-        cmdMenu = !cmdMenu;
-        if (cmdMenu)
-          showMenu();
-      }
-      delay(MIN_ELAPSED_TIME);
-      elapsedCommand = millis();
-    }
-  }
+
+  // Push button gestures (see onClick and onDoubleClick). It does not wait for the button release.
+  button.process();
 
   // Show RSSI status only if this condition has changed
   if ((millis() - elapsedRSSI) > MIN_ELAPSED_RSSI_TIME * 9)
@@ -717,12 +718,6 @@ void loop()
     elapsedCommand = millis();
   }
 
-  if ((millis() - elapsedClick) > ELAPSED_CLICK)
-  {
-    countClick = 0;
-    elapsedClick = millis();
-  }
-
   // Show the current frequency only if it has changed
   if (itIsTimeToSave)
   {
@@ -0,0 +1,28 @@
+/*
+  Minimal sketch used by footprint.sh to measure the flash and RAM used by the AKC695X library.
+  It uses just the methods available in the tiny build (see AKC695X_config.h).
+
+  By PU2CLR, Ricardo.
+*/
+
+#include <AKC695X.h>
+
+#define RESET_PIN 9
+
+AKC695X rx;
+
+void setup()
+{
+  rx.setup(RESET_PIN, CRYSTAL_32KHz);
+  rx.setFM(0, 870, 1080, 1039, 1);
+  rx.setAudio();
+}
+
+void loop()
+{
+  rx.frequencyUp();
+  rx.setVolume(rx.getRSSI() > 20 ? 40 : 30);
+  if (rx.getSupplyVoltageMillivolts() < 3000)
+    rx.setVolumeDown();
+  delay(1000);
+}
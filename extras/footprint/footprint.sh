@@ -0,0 +1,62 @@
+#!/bin/sh
+#
+# AKC695X Arduino Library footprint report
+#
+# Compiles a sketch with several library configurations (see AKC695X_config.h) and lists the flash and RAM used by each one.
+# Requires arduino-cli with the board core installed (arduino-cli core install arduino:avr).
+#
+# Usage: ./footprint.sh [sketch_folder] [fqbn]
+#   sketch_folder   default: akc695x_footprint (minimal sketch that works with all configurations)
+#   fqbn            default: arduino:avr:pro:cpu=8MHzatmega328 (ATmega328 3.3V/8MHz)
+#
+# Example: ./footprint.sh ../../examples/AKC_03_LCD16x2 "arduino:avr:pro:cpu=8MHzatmega328"
+#          The LCD example uses seekStation, so the tiny configuration must keep AKC695X_USE_SEEK=1 (see CONFIGS below).
+#
+# By PU2CLR, Ricardo.
+
+DIR=$(cd "$(dirname "$0")" && pwd)
+LIBRARY=$(cd "$DIR/../.." && pwd)
+SKETCH=${1:-$DIR/akc695x_footprint}
+FQBN=${2:-arduino:avr:pro:cpu=8MHzatmega328}
+
+# Configuration name and compiler flags
+CONFIGS="
+full|
+no_seek|-DAKC695X_USE_SEEK=0
+no_custom_band|-DAKC695X_USE_CUSTOM_BAND=0
+no_format|-DAKC695X_USE_FORMAT=0
+no_trace|-DAKC695X_USE_TRACE=0
+no_signal_cache|-DAKC695X_USE_SIGNAL_CACHE=0
+no_profiles|-DAKC695X_USE_PROFILES=0
+no_standby|-DAKC695X_USE_STANDBY=0
+no_float|-DAKC695X_USE_FLOAT=0
+no_band_plan|-DAKC695X_USE_BAND_PLAN=0
+no_scheduler|-DAKC695X_USE_SCHEDULER=0
+no_async|-DAKC695X_USE_ASYNC=0
+no_transaction|-DAKC695X_USE_TRANSACTION=0
+no_latency|-DAKC695X_USE_LATENCY=0
+no_tund|-DAKC695X_USE_TUND=0
+no_bandscope|-DAKC695X_USE_BANDSCOPE=0
+no_link|-DAKC695X_USE_LINK=0
+no_status|-DAKC695X_USE_STATUS=0
+no_scanner|-DAKC695X_USE_SCANNER=0
+no_dual_watch|-DAKC695X_USE_DUAL_WATCH=0
+no_bus_recovery|-DAKC695X_USE_BUS_RECOVERY=0
+no_telemetry|-DAKC695X_USE_TELEMETRY=0
+no_afc|-DAKC695X_USE_AFC=0
+no_ats|-DAKC695X_USE_ATS=0
+no_ramp|-DAKC695X_USE_RAMP=0
+no_button|-DAKC695X_USE_BUTTON=0
+tiny_with_seek|-DAKC695X_TINY -DAKC695X_USE_SEEK=1
+tiny|-DAKC695X_TINY
+"
+
+printf "%-20s %10s %10s\n" "configuration" "flash" "ram"
+echo "$CONFIGS" | while IFS='|' read -r NAME FLAGS; do
+    [ -z "$NAME" ] && continue
+    OUT=$(arduino-cli compile --fqbn "$FQBN" --library "$LIBRARY" \
+          --build-property "compiler.cpp.extra_flags=$FLAGS" "$SKETCH" 2>&1)
+    FLASH=$(echo "$OUT" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+    RAM=$(echo "$OUT" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')
+    printf "%-20s %10s %10s\n" "$NAME" "${FLASH:-error}" "${RAM:-error}"
+done
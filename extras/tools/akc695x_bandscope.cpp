@@ -0,0 +1,141 @@
+/**
+ * AKC695X bandscope viewer (host side)
+ *
+ * This program reads the bandscope frames sent by the AKC695X Arduino Library (see AKC695X::startBandscope and
+ * AKC695X::sendBandscopeFrame) and shows them as a text waterfall (one line per sweep) or as CSV.
+ *
+ * Compile: g++ -std=c++11 -O2 -o akc695x_bandscope akc695x_bandscope.cpp
+ *
+ * Usage:
+ *   akc695x_bandscope waterfall /dev/ttyUSB0    One line per sweep. Weak signals are shown as ' ', strong ones as '@'
+ *   akc695x_bandscope csv capture.bin           One line per sweep: sequence,frequency of the bin 0,step,level 0,level 1...
+ *
+ * Reading from Serial on Linux (the sketch must not print anything else on the same port):
+ *   stty -F /dev/ttyUSB0 115200 raw && akc695x_bandscope waterfall /dev/ttyUSB0
+ *
+ * Frame format: 0xB5, sequence, frequency of the bin 0 (16 bits little-endian), step, bins, runs,
+ *               runs * (first bin, number of bins, level), XOR of all bytes after 0xB5.
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#define BANDSCOPE_SYNC 0xB5
+
+struct Frame
+{
+    uint8_t seq;
+    uint16_t start;
+    uint8_t step;
+    uint8_t bins;
+    std::vector<uint8_t> runs;
+};
+
+static int readByte(FILE *f, uint8_t &checksum)
+{
+    int c = fgetc(f);
+    if (c != EOF)
+        checksum ^= (uint8_t)c;
+    return c;
+}
+
+// Reads the next valid frame. Bytes before the sync byte and frames with a wrong checksum are skipped.
+static bool readFrame(FILE *f, Frame &frame, unsigned &errors)
+{
+    int c;
+    uint8_t checksum, header[6];
+
+    while ((c = fgetc(f)) != EOF)
+    {
+        if (c != BANDSCOPE_SYNC)
+            continue;
+
+        checksum = 0;
+        for (int i = 0; i < 6; i++)
+        {
+            if ((c = readByte(f, checksum)) == EOF)
+                return false;
+            header[i] = (uint8_t)c;
+        }
+        frame.seq = header[0];
+        frame.start = header[1] | (header[2] << 8);
+        frame.step = header[3];
+        frame.bins = header[4];
+        frame.runs.resize(header[5] * 3);
+        for (size_t i = 0; i < frame.runs.size(); i++)
+        {
+            if ((c = readByte(f, checksum)) == EOF)
+                return false;
+            frame.runs[i] = (uint8_t)c;
+        }
+        if ((c = fgetc(f)) == EOF)
+            return false;
+        if ((uint8_t)c == checksum)
+            return true;
+        errors++;
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    static const char shades[] = " .:-=+*#%@";
+    Frame frame;
+    std::vector<uint8_t> levels;
+    unsigned errors = 0, lost = 0, frames = 0;
+    int last_seq = -1;
+    bool csv;
+    FILE *f;
+
+    if (argc != 3 || (strcmp(argv[1], "waterfall") != 0 && strcmp(argv[1], "csv") != 0))
+    {
+        fprintf(stderr, "usage: %s waterfall|csv <file or serial device>\n", argv[0]);
+        return 1;
+    }
+    csv = (strcmp(argv[1], "csv") == 0);
+
+    if ((f = fopen(argv[2], "rb")) == NULL)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+
+    while (readFrame(f, frame, errors))
+    {
+        if (frame.bins != levels.size())
+            levels.assign(frame.bins, 0); // New window
+        for (size_t i = 0; i + 2 < frame.runs.size(); i += 3)
+        {
+            for (unsigned b = frame.runs[i]; b < (unsigned)(frame.runs[i] + frame.runs[i + 1]) && b < levels.size(); b++)
+                levels[b] = frame.runs[i + 2];
+        }
+        if (last_seq >= 0)
+            lost += (uint8_t)(frame.seq - last_seq - 1);
+        last_seq = frame.seq;
+        frames++;
+
+        if (csv)
+        {
+            printf("%u,%u,%u", frame.seq, frame.start, frame.step);
+            for (size_t b = 0; b < levels.size(); b++)
+                printf(",%u", levels[b]);
+            printf("\n");
+        }
+        else
+        {
+            printf("%5u |", frame.start);
+            for (size_t b = 0; b < levels.size(); b++)
+                putchar(shades[(levels[b] > 63 ? 63 : levels[b]) * 10 / 64]);
+            printf("| %u\n", frame.start + (unsigned)(levels.size() - 1) * frame.step);
+        }
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%u frames, %u lost, %u checksum errors\n", frames, lost, errors);
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,433 @@
+/**
+ * AKC695X receiver daemon (host side, Linux)
+ *
+ * Shares one receiver among several local clients (logger, web UI, scanner etc). The receiver is controlled through the
+ * binary serial control protocol (see akc695x_link.h and the sketch akc695x_poc_03_link). The clients connect to a Unix
+ * domain socket and never talk to the receiver directly.
+ *
+ * Compile: g++ -std=c++11 -O2 -o akc695x_daemon akc695x_daemon.cpp
+ *
+ * Usage:
+ *   akc695x_daemon <serial device> [socket path] [poll time in ms]
+ *   default socket path: /tmp/akc695x.sock; default poll time: 500ms
+ *
+ * Example:
+ *   akc695x_daemon /dev/ttyUSB0 &
+ *   socat - UNIX-CONNECT:/tmp/akc695x.sock
+ *
+ * Socket API: one text command per line. Each command gets one reply line: "ok <status>" or "error <reason>".
+ *   fm <band> <min> <max> <freq> <step>    am <band> <min> <max> <freq> <step>
+ *   freq <frequency>   vol <volume>   seek up|down   reg <register> <value>   up   down
+ *   status                     current status
+ *   subscribe [threshold]      "event <status>" lines when the frequency, band, volume, tuned or stereo status change or
+ *                              when RSSI or CNR change at least threshold dB (default 3)
+ *   unsubscribe
+ *
+ * Status format: fm|am band <band> freq <frequency> vol <volume> rssi <dBuV> cnr <dB> tuned 0|1 stereo 0|1
+ *
+ * Request coalescing: the commands received while the receiver is busy are run together in the next round, in as few
+ * request frames as possible. All status queries of a round share the status read of the round. A set command of a
+ * client replaces its own queued command of the same kind (freq, vol or the same register) if no command that depends
+ * on the order (a tune command of other kind, or a register write) was queued after it. The rounds are serialized, so
+ * the tune commands of different clients never interleave inside a frame: they run in the order the clients are served
+ * and the last one wins.
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "akc695x_link.h"
+
+#define DAEMON_SOCKET "/tmp/akc695x.sock"
+#define DAEMON_POLL_TIME 500
+#define DAEMON_THRESHOLD 3
+#define DAEMON_MAX_LINE 256
+
+enum Kind
+{
+    CMD_FM,
+    CMD_AM,
+    CMD_FREQ,
+    CMD_VOL,
+    CMD_SEEK,
+    CMD_REG,
+    CMD_UP,
+    CMD_DOWN
+};
+
+struct Command
+{
+    Kind kind;
+    long arg[5];
+};
+
+struct Client
+{
+    int fd;
+    std::string input;
+    std::vector<Command> queue; // Set commands not sent yet
+    int waiting = 0;            // Command lines without reply
+    bool failed = false;        // A frame with commands of this client failed in the current round
+    bool subscribed = false;
+    int threshold = DAEMON_THRESHOLD;
+    bool notified = false;      // last is valid
+    Akc695xLink::Status last;
+};
+
+// Number of bytes of the command in a request frame (see Akc695xLink)
+static size_t commandSize(const Command &c)
+{
+    switch (c.kind)
+    {
+    case CMD_FM:
+    case CMD_AM:
+        return 9;
+    case CMD_FREQ:
+    case CMD_REG:
+        return 3;
+    case CMD_VOL:
+    case CMD_SEEK:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+static void addCommand(Akc695xLink &link, const Command &c)
+{
+    switch (c.kind)
+    {
+    case CMD_FM:
+        link.setFM(c.arg[0], c.arg[1], c.arg[2], c.arg[3], c.arg[4]);
+        break;
+    case CMD_AM:
+        link.setAM(c.arg[0], c.arg[1], c.arg[2], c.arg[3], c.arg[4]);
+        break;
+    case CMD_FREQ:
+        link.setFrequency(c.arg[0]);
+        break;
+    case CMD_VOL:
+        link.setVolume(c.arg[0]);
+        break;
+    case CMD_SEEK:
+        link.seek(c.arg[0]);
+        break;
+    case CMD_REG:
+        link.setRegister(c.arg[0], c.arg[1]);
+        break;
+    case CMD_UP:
+        link.frequencyUp();
+        break;
+    case CMD_DOWN:
+        link.frequencyDown();
+        break;
+    }
+}
+
+static bool isTune(const Command &c)
+{
+    return c.kind != CMD_VOL && c.kind != CMD_REG;
+}
+
+// true if the order of a and b cannot be changed
+static bool dependsOnOrder(const Command &a, const Command &b)
+{
+    if (a.kind == CMD_REG || b.kind == CMD_REG)
+        return true; // Any register can be written
+    return isTune(a) && isTune(b);
+}
+
+static bool sameSetting(const Command &a, const Command &b)
+{
+    if (a.kind != b.kind)
+        return false;
+    return a.kind == CMD_FREQ || a.kind == CMD_VOL || (a.kind == CMD_REG && a.arg[0] == b.arg[0]);
+}
+
+// Queues a set command. It replaces a queued command of the same setting if the order allows it.
+static void enqueue(Client &client, const Command &c)
+{
+    for (size_t i = client.queue.size(); i-- > 0;)
+    {
+        if (sameSetting(client.queue[i], c))
+        {
+            client.queue[i] = c;
+            return;
+        }
+        if (dependsOnOrder(client.queue[i], c))
+            break;
+    }
+    client.queue.push_back(c);
+}
+
+static void reply(Client &client, const std::string &line)
+{
+    std::string s = line + "\n";
+    send(client.fd, s.data(), s.size(), MSG_NOSIGNAL); // A client that does not read loses its replies
+}
+
+static std::string statusLine(const Akc695xLink::Status &s)
+{
+    char aux[128];
+    snprintf(aux, sizeof(aux), "%s band %u freq %u vol %u rssi %d cnr %u tuned %d stereo %d", s.fm ? "fm" : "am", s.band,
+             s.frequency, s.volume, s.rssi(), s.cnr(), s.tuned(), s.stereo());
+    return aux;
+}
+
+static bool statusChanged(const Akc695xLink::Status &a, const Akc695xLink::Status &b, int threshold)
+{
+    return a.fm != b.fm || a.band != b.band || a.frequency != b.frequency || a.volume != b.volume || a.tuned() != b.tuned() ||
+           a.stereo() != b.stereo() || abs(a.rssi() - b.rssi()) >= threshold || abs((int)a.cnr() - (int)b.cnr()) >= threshold;
+}
+
+// Parses a command line. Set commands are queued. Returns false if the command is invalid.
+static bool parse(Client &client, const std::string &line)
+{
+    std::istringstream in(line);
+    std::string name, word;
+    std::vector<long> args;
+    Command c;
+
+    if (!(in >> name))
+        return false;
+    while (in >> word)
+    {
+        if (name == "seek" && args.empty() && (word == "up" || word == "down"))
+            args.push_back(word == "up");
+        else
+        {
+            char *end;
+            long value = strtol(word.c_str(), &end, 0);
+            if (*end != '\0')
+                return false;
+            args.push_back(value);
+        }
+    }
+
+    if (name == "status" && args.empty())
+        return true;
+    if (name == "subscribe" && args.size() <= 1)
+    {
+        client.subscribed = true;
+        client.notified = false;
+        client.threshold = args.empty() ? DAEMON_THRESHOLD : args[0];
+        return true;
+    }
+    if (name == "unsubscribe" && args.empty())
+    {
+        client.subscribed = false;
+        return true;
+    }
+
+    if ((name == "fm" || name == "am") && args.size() == 5)
+        c.kind = (name == "fm") ? CMD_FM : CMD_AM;
+    else if (name == "freq" && args.size() == 1)
+        c.kind = CMD_FREQ;
+    else if (name == "vol" && args.size() == 1)
+        c.kind = CMD_VOL;
+    else if (name == "seek" && args.size() == 1)
+        c.kind = CMD_SEEK;
+    else if (name == "reg" && args.size() == 2)
+        c.kind = CMD_REG;
+    else if (name == "up" && args.empty())
+        c.kind = CMD_UP;
+    else if (name == "down" && args.empty())
+        c.kind = CMD_DOWN;
+    else
+        return false;
+
+    for (size_t i = 0; i < args.size(); i++)
+        c.arg[i] = args[i];
+    enqueue(client, c);
+    return true;
+}
+
+// Reads the lines received from a client. Returns false if the client has to be closed.
+static bool receive(Client &client)
+{
+    char buffer[512];
+    ssize_t n = recv(client.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    size_t end;
+
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR))
+        return false;
+    if (n > 0)
+        client.input.append(buffer, n);
+
+    while ((end = client.input.find('\n')) != std::string::npos)
+    {
+        std::string line = client.input.substr(0, end);
+        client.input.erase(0, end + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        if (parse(client, line))
+            client.waiting++;
+        else
+            reply(client, "error invalid command: " + line);
+    }
+    return client.input.size() <= DAEMON_MAX_LINE;
+}
+
+// Sends the frame being built. The clients with commands in it are marked if it fails.
+static bool sendFrame(Akc695xLink &link, Akc695xLink::Status &status, std::vector<Client *> &members)
+{
+    bool ok = link.send(status);
+    if (!ok)
+        for (Client *client : members)
+            client->failed = true;
+    members.clear();
+    return ok;
+}
+
+// Runs the queued commands of all clients in as few frames as possible and answers all waiting lines.
+static bool runRound(Akc695xLink &link, std::list<Client> &clients, Akc695xLink::Status &status)
+{
+    std::vector<Client *> members;
+    bool ok = true;
+
+    for (Client &client : clients)
+    {
+        client.failed = false;
+        for (const Command &c : client.queue)
+        {
+            if (link.pending() + commandSize(c) > LINK_MAX_PAYLOAD)
+                ok = sendFrame(link, status, members) && ok;
+            addCommand(link, c);
+            if (members.empty() || members.back() != &client)
+                members.push_back(&client);
+        }
+        client.queue.clear();
+    }
+    if (!sendFrame(link, status, members)) // The last frame brings the status of the round
+    {
+        for (Client &client : clients)
+            client.failed = true;
+        ok = false;
+    }
+
+    for (Client &client : clients)
+    {
+        for (; client.waiting > 0; client.waiting--)
+            reply(client, client.failed ? "error no reply or command rejected" : "ok " + statusLine(status));
+    }
+    return ok;
+}
+
+static void notify(std::list<Client> &clients, const Akc695xLink::Status &status)
+{
+    for (Client &client : clients)
+    {
+        if (!client.subscribed || (client.notified && !statusChanged(client.last, status, client.threshold)))
+            continue;
+        reply(client, "event " + statusLine(status));
+        client.last = status;
+        client.notified = true;
+    }
+}
+
+static long now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+int main(int argc, char **argv)
+{
+    Akc695xLink link;
+    Akc695xLink::Status status;
+    std::list<Client> clients;
+    std::vector<struct pollfd> fds;
+    struct sockaddr_un address;
+    const char *path = (argc > 2) ? argv[2] : DAEMON_SOCKET;
+    long poll_time = (argc > 3) ? atol(argv[3]) : DAEMON_POLL_TIME;
+    long next_poll = 0;
+    int server;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <serial device> [socket path] [poll time in ms]\n", argv[0]);
+        return 1;
+    }
+    if (!link.open(argv[1]))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    unlink(path);
+    if ((server = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 || bind(server, (struct sockaddr *)&address, sizeof(address)) < 0 ||
+        listen(server, 8) < 0)
+    {
+        perror(path);
+        return 1;
+    }
+
+    for (;;)
+    {
+        bool subscribers = false, waiting = false;
+        int timeout = -1;
+
+        fds.assign(1, {server, POLLIN, 0});
+        for (Client &client : clients)
+        {
+            fds.push_back({client.fd, POLLIN, 0});
+            subscribers = subscribers || client.subscribed;
+        }
+        if (subscribers)
+            timeout = (next_poll > now()) ? (int)(next_poll - now()) : 0;
+        if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR)
+        {
+            perror("poll");
+            return 1;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            int fd = accept(server, NULL, NULL);
+            if (fd >= 0)
+            {
+                clients.emplace_back();
+                clients.back().fd = fd;
+            }
+        }
+
+        // All the lines received so far go to the same round
+        size_t i = 1;
+        for (auto it = clients.begin(); it != clients.end(); i++)
+        {
+            if (i < fds.size() && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && !receive(*it))
+            {
+                close(it->fd);
+                it = clients.erase(it);
+                continue;
+            }
+            waiting = waiting || it->waiting > 0;
+            ++it;
+        }
+
+        if (waiting || (subscribers && now() >= next_poll))
+        {
+            if (runRound(link, clients, status))
+                notify(clients, status);
+            next_poll = now() + poll_time;
+        }
+    }
+}
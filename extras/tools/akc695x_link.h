@@ -0,0 +1,202 @@
+/**
+ * AKC695X binary serial control protocol (host side, Linux)
+ *
+ * Header-only implementation of the host side of AKC695XLink (see the GA14 section of the AKC695X Arduino Library).
+ * The commands are added to a batch and sent in a single request frame. The reply brings the receiver status.
+ * If the reply does not arrive, the request is sent again with the same sequence number. So, the receiver does not
+ * run the same batch twice.
+ *
+ * Usage:
+ *   #include "akc695x_link.h"
+ *
+ *   Akc695xLink link;
+ *   Akc695xLink::Status status;
+ *
+ *   link.open("/dev/ttyUSB0", 115200);
+ *   link.setFM(0, 870, 1080, 1039, 1).setVolume(40);
+ *   if (link.send(status))
+ *       printf("%u %d dBuV\n", status.frequency, status.rssi());
+ *
+ * See akc695x_remote.cpp for a command line example.
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#ifndef _AKC695X_LINK_H
+#define _AKC695X_LINK_H
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define LINK_SYNC 0xA6
+#define LINK_MAX_PAYLOAD 32
+#define LINK_OK 0
+#define LINK_CRC_ERROR 1
+#define LINK_BAD_COMMAND 2
+
+class Akc695xLink
+{
+public:
+    struct Status
+    {
+        uint8_t result;     // LINK_OK, LINK_CRC_ERROR or LINK_BAD_COMMAND
+        bool fm;            // true = FM mode
+        uint8_t band;       // current band
+        uint16_t frequency; // current frequency (FM = 100kHz; AM = 1kHz)
+        uint8_t volume;     // current volume
+        uint8_t regs[8];    // REG20 to REG27
+
+        bool stc() const { return regs[0] & 0x40; }
+        bool tuned() const { return regs[0] & 0x20; }
+        bool stereo() const { return regs[3] & 0x80; }
+        uint8_t cnr() const { return fm ? (regs[3] & 0x7F) : (regs[2] & 0x7F); }
+        int rssi() const // Same calculation of AKC695X::getRSSI
+        {
+            int factor = (fm || frequency > 3000) ? 103 : 123;
+            return factor - (regs[7] & 0x7F) - 6 * (((regs[4] >> 5) & 0x07) + ((regs[4] >> 2) & 0x07));
+        }
+    };
+
+    ~Akc695xLink() { close(); }
+
+    bool open(const char *device, int baud = 115200)
+    {
+        struct termios tty;
+        speed_t speed = (baud == 9600) ? B9600 : (baud == 57600) ? B57600 : (baud == 230400) ? B230400 : B115200;
+
+        if ((fd = ::open(device, O_RDWR | O_NOCTTY)) < 0)
+            return false;
+        memset(&tty, 0, sizeof(tty));
+        cfmakeraw(&tty);
+        cfsetispeed(&tty, speed);
+        cfsetospeed(&tty, speed);
+        tty.c_cflag |= CLOCAL | CREAD;
+        tty.c_cc[VMIN] = 0;
+        tty.c_cc[VTIME] = 0;
+        return tcsetattr(fd, TCSANOW, &tty) == 0;
+    }
+
+    void close()
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+
+    // Batch building. If the batch does not fit in a frame, ok() returns false and send() fails.
+    Akc695xLink &setFM(uint8_t band, uint16_t minimum, uint16_t maximum, uint16_t frequency, uint8_t step) { return addBand(0x01, band, minimum, maximum, frequency, step); }
+    Akc695xLink &setAM(uint8_t band, uint16_t minimum, uint16_t maximum, uint16_t frequency, uint8_t step) { return addBand(0x02, band, minimum, maximum, frequency, step); }
+    Akc695xLink &setFrequency(uint16_t frequency) { return add({0x03, (uint8_t)frequency, (uint8_t)(frequency >> 8)}); }
+    Akc695xLink &setVolume(uint8_t volume) { return add({0x04, volume}); }
+    Akc695xLink &seek(bool up) { return add({0x05, (uint8_t)up}); }
+    Akc695xLink &setRegister(uint8_t reg, uint8_t value) { return add({0x06, reg, value}); }
+    Akc695xLink &frequencyUp() { return add({0x07}); }
+    Akc695xLink &frequencyDown() { return add({0x08}); }
+    bool ok() const { return !overflow; }
+    size_t pending() const { return batch.size(); } // Bytes of the batch (up to LINK_MAX_PAYLOAD)
+
+    // Sends the batch (an empty batch just gets the status) and waits for the reply.
+    bool send(Status &status, int retries = 3, int timeout_ms = 500)
+    {
+        std::vector<uint8_t> request;
+        bool done = false;
+
+        if (fd < 0 || overflow)
+        {
+            batch.clear();
+            overflow = false;
+            return false;
+        }
+
+        seq++;
+        request.push_back(LINK_SYNC);
+        request.push_back(seq);
+        request.push_back((uint8_t)batch.size());
+        request.insert(request.end(), batch.begin(), batch.end());
+        request.push_back(crc8(&request[1], request.size() - 1));
+        batch.clear();
+
+        for (int attempt = 0; attempt <= retries && !done; attempt++)
+        {
+            if (write(fd, request.data(), request.size()) != (ssize_t)request.size())
+                return false;
+            done = receive(status, timeout_ms) && status.result != LINK_CRC_ERROR;
+        }
+        return done && status.result == LINK_OK;
+    }
+
+    static uint8_t crc8(const uint8_t *data, size_t length, uint8_t crc = 0)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+        return crc;
+    }
+
+private:
+    int fd = -1;
+    uint8_t seq = 0;
+    bool overflow = false;
+    std::vector<uint8_t> batch;
+
+    Akc695xLink &add(std::initializer_list<uint8_t> command)
+    {
+        if (batch.size() + command.size() > LINK_MAX_PAYLOAD)
+            overflow = true;
+        else
+            batch.insert(batch.end(), command.begin(), command.end());
+        return *this;
+    }
+
+    Akc695xLink &addBand(uint8_t id, uint8_t band, uint16_t minimum, uint16_t maximum, uint16_t frequency, uint8_t step)
+    {
+        return add({id, band, (uint8_t)minimum, (uint8_t)(minimum >> 8), (uint8_t)maximum, (uint8_t)(maximum >> 8),
+                    (uint8_t)frequency, (uint8_t)(frequency >> 8), step});
+    }
+
+    bool readByte(uint8_t &c, int timeout_ms)
+    {
+        struct pollfd p = {fd, POLLIN, 0};
+        return poll(&p, 1, timeout_ms) > 0 && read(fd, &c, 1) == 1;
+    }
+
+    // Waits for the reply of the current sequence number. Other bytes and old replies are skipped.
+    bool receive(Status &status, int timeout_ms)
+    {
+        uint8_t c, data[15];
+
+        while (readByte(c, timeout_ms))
+        {
+            if (c != LINK_SYNC)
+                continue;
+            for (int i = 0; i < 16; i++)
+            {
+                if (!readByte(c, timeout_ms))
+                    return false;
+                if (i < 15)
+                    data[i] = c;
+            }
+            if (data[1] != 13 || crc8(data, 15) != c || data[0] != seq)
+                continue;
+            status.result = data[2];
+            status.fm = data[3] & 0x80;
+            status.band = data[3] & 0x7F;
+            status.frequency = data[4] | (data[5] << 8);
+            status.volume = data[6];
+            memcpy(status.regs, &data[7], 8);
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // _AKC695X_LINK_H
@@ -0,0 +1,92 @@
+/**
+ * AKC695X remote control (host side, Linux)
+ *
+ * Command line example of the binary serial control protocol (see akc695x_link.h and the AKC695XLink class).
+ * All commands of the command line are sent in a single request frame.
+ *
+ * Compile: g++ -std=c++11 -O2 -o akc695x_remote akc695x_remote.cpp
+ *
+ * Usage:
+ *   akc695x_remote /dev/ttyUSB0 [command ...]
+ *
+ * Commands:
+ *   fm <band> <min> <max> <freq> <step>    am <band> <min> <max> <freq> <step>
+ *   freq <frequency>   vol <volume>   seek up|down   reg <register> <value>   up   down
+ *
+ * Example (FM band 0, 103.9MHz and volume 40 in one frame):
+ *   akc695x_remote /dev/ttyUSB0 fm 0 870 1080 1039 1 vol 40
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include "akc695x_link.h"
+
+int main(int argc, char **argv)
+{
+    Akc695xLink link;
+    Akc695xLink::Status status;
+    int i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <serial device> [command ...]\n", argv[0]);
+        return 1;
+    }
+    if (!link.open(argv[1]))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    for (i = 2; i < argc; i++)
+    {
+        const char *cmd = argv[i];
+        int left = argc - i - 1;
+        if ((!strcmp(cmd, "fm") || !strcmp(cmd, "am")) && left >= 5)
+        {
+            if (cmd[0] == 'f')
+                link.setFM(atoi(argv[i + 1]), atoi(argv[i + 2]), atoi(argv[i + 3]), atoi(argv[i + 4]), atoi(argv[i + 5]));
+            else
+                link.setAM(atoi(argv[i + 1]), atoi(argv[i + 2]), atoi(argv[i + 3]), atoi(argv[i + 4]), atoi(argv[i + 5]));
+            i += 5;
+        }
+        else if (!strcmp(cmd, "freq") && left >= 1)
+            link.setFrequency(atoi(argv[++i]));
+        else if (!strcmp(cmd, "vol") && left >= 1)
+            link.setVolume(atoi(argv[++i]));
+        else if (!strcmp(cmd, "seek") && left >= 1)
+            link.seek(!strcmp(argv[++i], "up"));
+        else if (!strcmp(cmd, "reg") && left >= 2)
+        {
+            link.setRegister(strtol(argv[i + 1], NULL, 0), strtol(argv[i + 2], NULL, 0));
+            i += 2;
+        }
+        else if (!strcmp(cmd, "up"))
+            link.frequencyUp();
+        else if (!strcmp(cmd, "down"))
+            link.frequencyDown();
+        else
+        {
+            fprintf(stderr, "invalid command: %s\n", cmd);
+            return 1;
+        }
+    }
+
+    if (!link.ok())
+    {
+        fprintf(stderr, "too many commands for a single frame\n");
+        return 1;
+    }
+    if (!link.send(status))
+    {
+        fprintf(stderr, "no reply or command rejected\n");
+        return 1;
+    }
+
+    printf("%s band %u, frequency %u, volume %u, RSSI %d dBuV, CNR %u dB%s%s\n", status.fm ? "FM" : "AM", status.band,
+           status.frequency, status.volume, status.rssi(), status.cnr(), status.tuned() ? ", tuned" : "",
+           status.stereo() ? ", stereo" : "");
+    return 0;
+}
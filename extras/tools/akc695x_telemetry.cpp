@@ -0,0 +1,275 @@
+/**
+ * AKC695X telemetry decoder (host side)
+ *
+ * This program reads the telemetry pages recorded by the AKC695X Arduino Library (see AKC695X::setTelemetry and
+ * AKC695X::dumpTelemetry) and exports the samples as CSV.
+ *
+ * Compile: g++ -std=c++11 -O2 -o akc695x_telemetry akc695x_telemetry.cpp
+ *
+ * Usage:
+ *   akc695x_telemetry capture.bin > samples.csv
+ *
+ * Capturing the pages from Serial on Linux (the sketch must not print anything else on the same port):
+ *   stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > capture.bin
+ *
+ * Page format: 0xA7, sequence (16 bits little-endian), n, n bytes of records, XOR of all bytes after 0xA7.
+ * The bytes between pages (EEPROM padding, for example) are skipped. Each page starts with a keyframe, so a page
+ * with a wrong checksum does not affect the others. After a wrong checksum, the search for the next page starts at the
+ * byte after the 0xA7 (it can be a 0xA7 in the padding).
+ *
+ * The same page can appear more than once: dumpTelemetry sends the page being filled, which is sent again when it is
+ * closed, and a new dump sends the whole ring again. A page with a known sequence number whose records start with the
+ * records already decoded only adds its new samples. Pages are counted as lost only when the sequence number moves
+ * forward more than one (it goes back to 0 when the sketch starts a new recording).
+ *
+ * Record format: tag, then varints (7 bits per byte, least significant first). Signed values are zigzag encoded.
+ *   keyframe (tag bit 7 = 1): time, frequency, RSSI, CNR, vbat. Tag bit 0 = FM.
+ *   delta    (tag bit 7 = 0): tag bits 0 to 4 = time delta, frequency, RSSI, CNR and vbat differences present.
+ *   Both: tag bit 6 = tuned, tag bit 5 = stereo.
+ *
+ * The CSV columns are: seconds since startTelemetry, mode, frequency (FM: 100kHz; AM: kHz), RSSI (dBuV), CNR (dB),
+ * supply voltage (mV), stereo, tuned. The sizes of the capture and of the CSV are shown at the end.
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+#define TELEMETRY_SYNC 0xA7
+#define TELEMETRY_TIME_UNIT 100
+#define TELEMETRY_KEYFRAME 0x80
+#define TELEMETRY_TUNED 0x40
+#define TELEMETRY_STEREO 0x20
+#define TELEMETRY_FM 0x01
+
+struct Page
+{
+    uint16_t seq;
+    std::vector<uint8_t> records;
+};
+
+struct Sample
+{
+    uint32_t time;
+    uint32_t delta;
+    int32_t frequency;
+    int32_t rssi;
+    int32_t cnr;
+    int32_t vbat;
+    bool fm;
+    bool stereo;
+    bool tuned;
+};
+
+// Input with push back. The bytes of a rejected page are read again, starting after its sync byte.
+struct Input
+{
+    FILE *f;
+    std::deque<uint8_t> pending;
+    unsigned long bytes = 0;
+
+    int get()
+    {
+        int c;
+        if (!pending.empty())
+        {
+            c = pending.front();
+            pending.pop_front();
+            return c;
+        }
+        if ((c = fgetc(f)) != EOF)
+            bytes++;
+        return c;
+    }
+
+    void unget(const std::vector<uint8_t> &data) { pending.insert(pending.begin(), data.begin(), data.end()); }
+};
+
+// Reads the next valid page. Bytes before the sync byte and pages with a wrong checksum are skipped.
+static bool readPage(Input &in, Page &page, unsigned &errors)
+{
+    int c;
+    uint8_t checksum;
+    std::vector<uint8_t> data; // Bytes after the sync byte
+
+    while ((c = in.get()) != EOF)
+    {
+        if (c != TELEMETRY_SYNC)
+            continue;
+
+        // Header (3 bytes), records and checksum
+        data.clear();
+        for (size_t size = 4; data.size() < size && (c = in.get()) != EOF;)
+        {
+            data.push_back((uint8_t)c);
+            if (data.size() == 3)
+                size += data[2];
+        }
+        if (c != EOF)
+        {
+            checksum = 0;
+            for (size_t i = 0; i < data.size() - 1; i++)
+                checksum ^= data[i];
+            if (checksum == data.back())
+            {
+                page.seq = data[0] | (data[1] << 8);
+                page.records.assign(data.begin() + 3, data.end() - 1);
+                return true;
+            }
+            errors++;
+        }
+        in.unget(data); // The sync byte can be a false one. Searches again from the next byte.
+    }
+    return false;
+}
+
+static bool readVarint(const std::vector<uint8_t> &data, size_t &pos, uint32_t &value)
+{
+    value = 0;
+    for (int shift = 0; pos < data.size() && shift < 35; shift += 7)
+    {
+        uint8_t c = data[pos++];
+        value |= (uint32_t)(c & 0x7F) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+static int32_t unzigzag(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// Decodes the records of a page. The first skip samples are not printed (already decoded).
+// Returns the number of samples or -1 if the page is invalid.
+static int decodePage(const Page &page, int skip, unsigned long &csv_bytes)
+{
+    Sample s = {};
+    size_t pos = 0;
+    uint32_t v[5];
+    int samples = 0;
+
+    while (pos < page.records.size())
+    {
+        uint8_t tag = page.records[pos++];
+
+        if (tag & TELEMETRY_KEYFRAME)
+        {
+            for (int i = 0; i < 5; i++)
+                if (!readVarint(page.records, pos, v[i]))
+                    return -1;
+            s.time = v[0];
+            s.delta = 0;
+            s.frequency = v[1];
+            s.rssi = unzigzag(v[2]);
+            s.cnr = v[3];
+            s.vbat = v[4];
+            s.fm = tag & TELEMETRY_FM;
+        }
+        else
+        {
+            if (samples == 0)
+                return -1; // The first record must be a keyframe
+            if ((tag & 0x01) && !readVarint(page.records, pos, s.delta))
+                return -1;
+            s.time += s.delta;
+            int32_t *fields[4] = {&s.frequency, &s.rssi, &s.cnr, &s.vbat};
+            for (int i = 0; i < 4; i++)
+            {
+                if (!(tag & (0x02 << i)))
+                    continue;
+                if (!readVarint(page.records, pos, v[0]))
+                    return -1;
+                *fields[i] += unzigzag(v[0]);
+            }
+        }
+        s.stereo = tag & TELEMETRY_STEREO;
+        s.tuned = tag & TELEMETRY_TUNED;
+
+        if (samples++ < skip)
+            continue;
+        int n = printf("%.1f,%s,%d,%d,%d,%d,%d,%d\n", s.time * (TELEMETRY_TIME_UNIT / 1000.0), s.fm ? "FM" : "AM", s.frequency,
+                       s.rssi, s.cnr, 1800 + 50 * s.vbat, s.stereo, s.tuned);
+        if (n > 0)
+            csv_bytes += n;
+    }
+    return samples;
+}
+
+// Pages already decoded: records and number of samples
+struct Known
+{
+    std::vector<uint8_t> records;
+    int samples;
+};
+
+int main(int argc, char **argv)
+{
+    Page page;
+    Input in;
+    std::map<uint16_t, Known> known;
+    unsigned errors = 0, lost = 0, pages = 0, invalid = 0, repeated = 0;
+    unsigned long csv_bytes = 0, samples = 0;
+    int last_seq = -1, n, skip;
+    FILE *f;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <file or serial device>\n", argv[0]);
+        return 1;
+    }
+    if ((f = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    in.f = f;
+    printf("time,mode,frequency,rssi,cnr,vbat,stereo,tuned\n");
+    while (readPage(in, page, errors))
+    {
+        // A known page (same sequence number and same first records) only adds the samples not decoded yet
+        auto it = known.find(page.seq);
+        skip = 0;
+        if (it != known.end() &&
+            std::equal(page.records.begin(), page.records.begin() + std::min(page.records.size(), it->second.records.size()),
+                       it->second.records.begin()))
+        {
+            skip = it->second.samples;
+            repeated++;
+        }
+        else
+        {
+            if (last_seq >= 0 && (int16_t)(page.seq - last_seq) > 1)
+                lost += (uint16_t)(page.seq - last_seq - 1);
+            last_seq = page.seq;
+            pages++;
+        }
+
+        if ((n = decodePage(page, skip, csv_bytes)) < 0)
+        {
+            invalid++;
+            continue;
+        }
+        if (n > skip)
+        {
+            samples += n - skip;
+            known[page.seq] = {page.records, n};
+        }
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%u pages, %u repeated, %u lost, %u checksum errors, %u invalid\n", pages, repeated, lost, errors, invalid);
+    if (samples > 0)
+        fprintf(stderr, "%lu samples: %lu bytes (%.1f bytes/sample) against %lu bytes of CSV (%.1fx)\n", samples, in.bytes,
+                (double)in.bytes / samples, csv_bytes, in.bytes ? (double)csv_bytes / in.bytes : 0.0);
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * AKC695X I2C trace tool (host side)
+ *
+ * This program reads the binary I2C trace captured by the AKC695X Arduino Library (see AKC695X::setTraceBuffer,
+ * AKC695X::setTraceOutput and AKC695X::dumpTrace) and shows where the bus time was spent.
+ *
+ * Compile: g++ -std=c++11 -O2 -o akc695x_trace akc695x_trace.cpp
+ *
+ * Usage:
+ *   akc695x_trace summary trace.bin        Transactions and bus time per API call
+ *   akc695x_trace dump trace.bin           One line per record
+ *   akc695x_trace diff before.bin after.bin  Compares two traces (first divergence and cost per API call)
+ *
+ * Capturing a trace from Serial on Linux (the sketch must not print anything else on the same port):
+ *   stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > trace.bin
+ *
+ * Record format (4 bytes): op_reg (bits 6-7 = op; bits 0-5 = register or API id), value, delta (16 bits little-endian, 16us units).
+ * The library marks only the outermost API call. The bus time of nested calls (setFM calls setFrequency) is charged to the
+ * method called by the sketch.
+ *
+ * By PU2CLR, Ricardo.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <map>
+
+#define TRACE_WRITE 0
+#define TRACE_READ 1
+#define TRACE_MARK 2
+#define TRACE_TIME_UNIT 16
+
+struct Record
+{
+    uint8_t op;
+    uint8_t reg;
+    uint8_t value;
+    uint32_t delta_us;
+};
+
+struct ApiCost
+{
+    uint32_t calls = 0;
+    uint32_t writes = 0;
+    uint32_t reads = 0;
+    uint64_t time_us = 0;
+};
+
+static const char *apiName(uint8_t id)
+{
+    static const char *names[] = {"(before any marker)", "setup", "setFM", "setAM", "setFrequency", "seekStation",
+                                  "setAudio", "setVolume", "getRSSI", "refreshSignalCache"};
+    static char aux[16];
+    if (id < sizeof(names) / sizeof(names[0]))
+        return names[id];
+    snprintf(aux, sizeof(aux), "api_%u", id);
+    return aux;
+}
+
+static bool load(const char *file_name, std::vector<Record> &records)
+{
+    FILE *f = fopen(file_name, "rb");
+    uint8_t b[4];
+
+    if (f == NULL)
+    {
+        perror(file_name);
+        return false;
+    }
+    while (fread(b, 1, 4, f) == 4)
+    {
+        Record r;
+        r.op = b[0] >> 6;
+        r.reg = b[0] & 0x3F;
+        r.value = b[1];
+        r.delta_us = (uint32_t)(b[2] | (b[3] << 8)) * TRACE_TIME_UNIT;
+        records.push_back(r);
+    }
+    fclose(f);
+    return true;
+}
+
+// The time of a register operation is the time elapsed since the previous record.
+// The time before a marker is the sketch idle time and it is not assigned to any API call.
+static std::map<uint8_t, ApiCost> summarize(const std::vector<Record> &records)
+{
+    std::map<uint8_t, ApiCost> cost;
+    uint8_t current = 0;
+
+    for (const Record &r : records)
+    {
+        if (r.op == TRACE_MARK)
+        {
+            current = r.reg;
+            cost[current].calls++;
+            continue;
+        }
+        ApiCost &c = cost[current];
+        if (r.op == TRACE_WRITE)
+            c.writes++;
+        else
+            c.reads++;
+        c.time_us += r.delta_us;
+    }
+    return cost;
+}
+
+static void printSummary(const std::vector<Record> &records)
+{
+    std::map<uint8_t, ApiCost> cost = summarize(records);
+    ApiCost total;
+
+    printf("%-20s %8s %8s %8s %12s %12s\n", "API", "calls", "writes", "reads", "bus_us", "us/call");
+    for (auto &it : cost)
+    {
+        const ApiCost &c = it.second;
+        printf("%-20s %8u %8u %8u %12llu %12llu\n", apiName(it.first), c.calls, c.writes, c.reads,
+               (unsigned long long)c.time_us, (unsigned long long)(c.calls ? c.time_us / c.calls : 0));
+        total.calls += c.calls;
+        total.writes += c.writes;
+        total.reads += c.reads;
+        total.time_us += c.time_us;
+    }
+    printf("%-20s %8u %8u %8u %12llu\n", "TOTAL", total.calls, total.writes, total.reads, (unsigned long long)total.time_us);
+}
+
+static void printDump(const std::vector<Record> &records)
+{
+    static const char *ops[] = {"W", "R", "API", "?"};
+    uint64_t t = 0;
+
+    for (const Record &r : records)
+    {
+        t += r.delta_us;
+        if (r.op == TRACE_MARK)
+            printf("%10llu us  %-3s %s\n", (unsigned long long)t, ops[r.op], apiName(r.reg));
+        else
+            printf("%10llu us  %-3s REG 0x%02X = 0x%02X\n", (unsigned long long)t, ops[r.op], r.reg, r.value);
+    }
+}
+
+static void printDiff(const std::vector<Record> &a, const std::vector<Record> &b)
+{
+    std::map<uint8_t, ApiCost> ca = summarize(a), cb = summarize(b);
+    std::map<uint8_t, bool> apis;
+    size_t i;
+
+    for (i = 0; i < a.size() && i < b.size(); i++)
+    {
+        if (a[i].op != b[i].op || a[i].reg != b[i].reg || a[i].value != b[i].value)
+            break;
+    }
+    if (i == a.size() && i == b.size())
+        printf("Same register operations (%zu records)\n", i);
+    else
+        printf("First divergence at record %zu\n", i);
+
+    for (auto &it : ca)
+        apis[it.first] = true;
+    for (auto &it : cb)
+        apis[it.first] = true;
+
+    printf("%-20s %-20s %s\n", "API", "transactions", "bus_us");
+    for (auto &it : apis)
+    {
+        const ApiCost &x = ca[it.first], &y = cb[it.first];
+        printf("%-20s %8u -> %-8u %10llu -> %-10llu\n", apiName(it.first), x.writes + x.reads, y.writes + y.reads,
+               (unsigned long long)x.time_us, (unsigned long long)y.time_us);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<Record> a, b;
+
+    if (argc == 3 && strcmp(argv[1], "summary") == 0 && load(argv[2], a))
+        printSummary(a);
+    else if (argc == 3 && strcmp(argv[1], "dump") == 0 && load(argv[2], a))
+        printDump(a);
+    else if (argc == 4 && strcmp(argv[1], "diff") == 0 && load(argv[2], a) && load(argv[3], b))
+        printDiff(a, b);
+    else
+    {
+        fprintf(stderr, "Usage: %s summary|dump <trace.bin>\n       %s diff <before.bin> <after.bin>\n", argv[0], argv[0]);
+        return 1;
+    }
+    return 0;
+}